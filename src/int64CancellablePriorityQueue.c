@@ -0,0 +1,434 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ---------------------------------------------------------------------------
+// Int64Set (open addressing with linear probing, as in int64Set.c).
+// Tombstones left by removals are counted so that a set which sees many
+// insert/remove cycles is rehashed instead of degrading into full scans.
+// ---------------------------------------------------------------------------
+
+typedef enum { EMPTY, OCCUPIED, DELETED } SlotState;
+
+typedef struct {
+    int64_t key;
+    SlotState state;
+} HashSlot;
+
+typedef struct {
+    HashSlot *slots;
+    size_t size;       // OCCUPIED slots
+    size_t tombstones; // DELETED slots
+    size_t capacity;
+    float loadFactor;
+} Int64Set;
+
+static inline uint64_t int64Hash(int64_t key) {
+    uint64_t x = (uint64_t)key;
+    x = ((x >> 30) ^ x) * 0xbf58476d1ce4e5b9ULL;
+    x = ((x >> 27) ^ x) * 0x94d049bb133111ebULL;
+    x = (x >> 31) ^ x;
+    return x;
+}
+
+// Rehash all keys into a table of newCapacity slots, dropping tombstones
+static bool int64SetResize(Int64Set *set, size_t newCapacity) {
+    HashSlot *newSlots = calloc(newCapacity, sizeof(HashSlot));
+    if (!newSlots) {
+        fprintf(stderr, "Failed to allocate memory for new HashSlot array\n");
+        return false;
+    }
+    for (size_t i = 0; i < set->capacity; i++) {
+        if (set->slots[i].state != OCCUPIED)
+            continue;
+        size_t probe = int64Hash(set->slots[i].key) % newCapacity;
+        while (newSlots[probe].state == OCCUPIED)
+            probe = (probe + 1) % newCapacity;
+        newSlots[probe] = set->slots[i];
+    }
+    free(set->slots);
+    set->slots = newSlots;
+    set->capacity = newCapacity;
+    set->tombstones = 0;
+    return true;
+}
+
+static Int64Set *int64SetCreate(size_t capacity, float loadFactor) {
+    Int64Set *set = calloc(1, sizeof(Int64Set));
+    if (!set) {
+        fprintf(stderr, "Failed to allocate memory for Int64Set\n");
+        return NULL;
+    }
+    set->capacity = capacity;
+    set->loadFactor = loadFactor;
+    set->slots = calloc(capacity, sizeof(HashSlot));
+    if (!set->slots) {
+        fprintf(stderr, "Failed to allocate memory for HashSlot array\n");
+        free(set);
+        return NULL;
+    }
+    return set;
+}
+
+static bool int64SetContains(const Int64Set *set, int64_t key) {
+    size_t probe = int64Hash(key) % set->capacity;
+    for (size_t i = 0; i < set->capacity; i++) {
+        if (set->slots[probe].state == EMPTY)
+            return false;
+        if (set->slots[probe].state == OCCUPIED && set->slots[probe].key == key)
+            return true;
+        probe = (probe + 1) % set->capacity;
+    }
+    return false;
+}
+
+// Insert a key; return false if it already exists or allocation fails
+static bool int64SetInsert(Int64Set *set, int64_t key) {
+    if ((double)(set->size + set->tombstones + 1) / set->capacity >
+        set->loadFactor) {
+        // Grow only if live keys need the room, otherwise just clean up
+        size_t newCapacity =
+            (double)(set->size + 1) / set->capacity > set->loadFactor / 2
+                ? set->capacity * 2
+                : set->capacity;
+        if (!int64SetResize(set, newCapacity))
+            return false;
+    }
+    if (int64SetContains(set, key))
+        return false;
+
+    size_t probe = int64Hash(key) % set->capacity;
+    while (set->slots[probe].state == OCCUPIED)
+        probe = (probe + 1) % set->capacity;
+    if (set->slots[probe].state == DELETED)
+        set->tombstones--;
+    set->slots[probe].key = key;
+    set->slots[probe].state = OCCUPIED;
+    set->size++;
+    return true;
+}
+
+static bool int64SetRemove(Int64Set *set, int64_t key) {
+    size_t probe = int64Hash(key) % set->capacity;
+    for (size_t i = 0; i < set->capacity; i++) {
+        if (set->slots[probe].state == EMPTY)
+            return false;
+        if (set->slots[probe].state == OCCUPIED &&
+            set->slots[probe].key == key) {
+            set->slots[probe].state = DELETED;
+            set->size--;
+            set->tombstones++;
+            return true;
+        }
+        probe = (probe + 1) % set->capacity;
+    }
+    return false;
+}
+
+// Remove every key, keeping the table
+static void int64SetClear(Int64Set *set) {
+    memset(set->slots, 0, set->capacity * sizeof(HashSlot));
+    set->size = 0;
+    set->tombstones = 0;
+}
+
+static void int64SetDestroy(Int64Set *set) {
+    if (set) {
+        free(set->slots);
+        free(set);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Cancellable priority queue
+// ---------------------------------------------------------------------------
+
+// Live/dead accounting
+typedef struct {
+    size_t live;      // queued and not cancelled
+    size_t dead;      // cancelled but still occupying heap slots
+    size_t skipped;   // cancelled entries discarded at the top by pop/peek
+    size_t purged;    // cancelled entries discarded by rebuilds
+    size_t rebuilds;  // number of O(n) purges
+} CancellablePriorityQueueStats;
+
+// Max priority queue of job ids with lazy cancellation.
+// Cancelling only records the id in a set; the heap slot becomes dead and is
+// discarded when it reaches the top. Once dead entries exceed `purgeFraction`
+// of the heap, the array is compacted and re-heapified in O(n), so cancelled
+// work never costs more than a constant factor in memory or pops.
+// Ids are assumed unique among queued entries.
+typedef struct {
+    int64_t *data;   // heap array, live and dead entries
+    size_t size;     // number of entries in the heap array
+    size_t capacity; // maximum number of entries in the heap array
+    Int64Set *cancelled;
+    double purgeFraction; // rebuild when dead > purgeFraction * size
+    CancellablePriorityQueueStats stats;
+} Int64CancellablePriorityQueue;
+
+// Restore the max-heap property moving the value at i up
+static void heapifyUp(int64_t *data, size_t i) {
+    int64_t value = data[i];
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (data[parent] >= value)
+            break;
+        data[i] = data[parent];
+        i = parent;
+    }
+    data[i] = value;
+}
+
+// Restore the max-heap property moving the value at i down
+static void heapifyDown(int64_t *data, size_t size, size_t i) {
+    int64_t value = data[i];
+    while (true) {
+        size_t child = 2 * i + 1;
+        if (child >= size)
+            break;
+        if (child + 1 < size && data[child + 1] > data[child])
+            child++;
+        if (data[child] <= value)
+            break;
+        data[i] = data[child];
+        i = child;
+    }
+    data[i] = value;
+}
+
+// Create a queue. purgeFraction must be in (0, 1]; 1 never purges early.
+Int64CancellablePriorityQueue *
+int64CancellablePriorityQueueCreate(size_t initialCapacity,
+                                    double purgeFraction) {
+    if (purgeFraction <= 0.0 || purgeFraction > 1.0) {
+        fprintf(stderr, "Invalid purge fraction: %f, only accept (0, 1]\n",
+                purgeFraction);
+        return NULL;
+    }
+    Int64CancellablePriorityQueue *pq = calloc(1, sizeof(*pq));
+    if (!pq) {
+        fprintf(stderr,
+                "Memory allocation failed for Int64CancellablePriorityQueue\n");
+        return NULL;
+    }
+    pq->capacity = initialCapacity > 0 ? initialCapacity : 1;
+    pq->data = malloc(pq->capacity * sizeof(int64_t));
+    pq->cancelled = int64SetCreate(64, 0.5f);
+    pq->purgeFraction = purgeFraction;
+    if (!pq->data || !pq->cancelled) {
+        fprintf(stderr, "Memory allocation failed for queue storage\n");
+        free(pq->data);
+        int64SetDestroy(pq->cancelled);
+        free(pq);
+        return NULL;
+    }
+    return pq;
+}
+
+void int64CancellablePriorityQueueDestroy(Int64CancellablePriorityQueue *pq) {
+    if (!pq)
+        return;
+    free(pq->data);
+    int64SetDestroy(pq->cancelled);
+    free(pq);
+}
+
+// Push a job id.
+bool int64CancellablePriorityQueuePush(Int64CancellablePriorityQueue *pq,
+                                       int64_t id) {
+    if (pq->size == pq->capacity) {
+        size_t newCapacity = pq->capacity * 2;
+        int64_t *newData = realloc(pq->data, newCapacity * sizeof(int64_t));
+        if (!newData) {
+            fprintf(stderr, "Memory (re)allocation failed for capacity %zu\n",
+                    newCapacity);
+            return false;
+        }
+        pq->data = newData;
+        pq->capacity = newCapacity;
+    }
+    pq->data[pq->size] = id;
+    heapifyUp(pq->data, pq->size);
+    pq->size++;
+    pq->stats.live++;
+    return true;
+}
+
+// Drop every dead entry and rebuild the heap in O(n)
+void int64CancellablePriorityQueuePurge(Int64CancellablePriorityQueue *pq) {
+    if (pq->stats.dead == 0)
+        return;
+    size_t kept = 0;
+    for (size_t i = 0; i < pq->size; i++) {
+        if (!int64SetContains(pq->cancelled, pq->data[i]))
+            pq->data[kept++] = pq->data[i];
+    }
+    pq->stats.purged += pq->size - kept;
+    pq->size = kept;
+    pq->stats.dead = 0;
+    pq->stats.rebuilds++;
+    int64SetClear(pq->cancelled);
+    if (kept > 1) {
+        for (size_t i = (kept - 2) / 2 + 1; i-- > 0;)
+            heapifyDown(pq->data, kept, i);
+    }
+}
+
+// Cancel a queued job id. The caller must only cancel ids that are queued.
+// Return false if the id is already cancelled (or allocation fails).
+bool int64CancellablePriorityQueueCancel(Int64CancellablePriorityQueue *pq,
+                                         int64_t id) {
+    if (pq->stats.live == 0 || !int64SetInsert(pq->cancelled, id))
+        return false;
+    pq->stats.live--;
+    pq->stats.dead++;
+    if ((double)pq->stats.dead > pq->purgeFraction * (double)pq->size)
+        int64CancellablePriorityQueuePurge(pq);
+    return true;
+}
+
+// Pop dead entries off the top until the root is live
+static void skipCancelled(Int64CancellablePriorityQueue *pq) {
+    while (pq->stats.dead > 0 &&
+           int64SetRemove(pq->cancelled, pq->data[0])) {
+        pq->size--;
+        pq->data[0] = pq->data[pq->size];
+        heapifyDown(pq->data, pq->size, 0);
+        pq->stats.dead--;
+        pq->stats.skipped++;
+    }
+}
+
+// Pop the highest live job id.
+int64_t int64CancellablePriorityQueuePop(Int64CancellablePriorityQueue *pq) {
+    if (pq->stats.live == 0) {
+        fprintf(stderr, "Error: pop() called on empty priority queue\n");
+        exit(EXIT_FAILURE);
+    }
+    skipCancelled(pq);
+    int64_t root = pq->data[0];
+    pq->size--;
+    if (pq->size > 0) {
+        pq->data[0] = pq->data[pq->size];
+        heapifyDown(pq->data, pq->size, 0);
+    }
+    pq->stats.live--;
+    return root;
+}
+
+// Peek at the highest live job id (discarding dead entries above it).
+int64_t int64CancellablePriorityQueuePeek(Int64CancellablePriorityQueue *pq) {
+    if (pq->stats.live == 0) {
+        fprintf(stderr, "Error: peek() called on empty priority queue\n");
+        exit(EXIT_FAILURE);
+    }
+    skipCancelled(pq);
+    return pq->data[0];
+}
+
+// Check if the queue has no live entries.
+bool int64CancellablePriorityQueueIsEmpty(
+    const Int64CancellablePriorityQueue *pq) {
+    return pq->stats.live == 0;
+}
+
+// Get the number of live entries.
+size_t
+int64CancellablePriorityQueueSize(const Int64CancellablePriorityQueue *pq) {
+    return pq->stats.live;
+}
+
+// Get the live/dead accounting.
+CancellablePriorityQueueStats
+int64CancellablePriorityQueueStats(const Int64CancellablePriorityQueue *pq) {
+    return pq->stats;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void printStats(const char *label,
+                       const Int64CancellablePriorityQueue *pq) {
+    CancellablePriorityQueueStats s = int64CancellablePriorityQueueStats(pq);
+    printf("%s: live %zu, dead %zu, skipped %zu, purged %zu, rebuilds %zu\n",
+           label, s.live, s.dead, s.skipped, s.purged, s.rebuilds);
+}
+
+// Scheduler workload: every round submits a batch of jobs, cancels most of
+// them, and dispatches a few of the best live ones.
+static void benchmark(double purgeFraction, size_t rounds) {
+    Int64CancellablePriorityQueue *pq =
+        int64CancellablePriorityQueueCreate(1024, purgeFraction);
+    if (!pq)
+        return;
+
+    const size_t batch = 1000, cancelled = 900, dispatched = 80;
+    int64_t *ids = malloc(batch * sizeof(int64_t));
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    size_t peakSlots = 0, dispatchedTotal = 0;
+    double start = nowSeconds();
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < batch; i++) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            // Priority in the high bits, unique sequence number in the low
+            ids[i] = (int64_t)((state >> 40) << 32 | (r * batch + i));
+            int64CancellablePriorityQueuePush(pq, ids[i]);
+        }
+        for (size_t i = 0; i < cancelled; i++)
+            int64CancellablePriorityQueueCancel(pq, ids[i]);
+        for (size_t i = 0;
+             i < dispatched && !int64CancellablePriorityQueueIsEmpty(pq); i++) {
+            int64CancellablePriorityQueuePop(pq);
+            dispatchedTotal++;
+        }
+        if (pq->size > peakSlots)
+            peakSlots = pq->size;
+    }
+    double elapsed = nowSeconds() - start;
+
+    char label[64];
+    snprintf(label, sizeof(label), "purge at %.0f%%", purgeFraction * 100);
+    printf("%s: %.3f s, %zu dispatched, peak heap slots %zu\n", label,
+           elapsed, dispatchedTotal, peakSlots);
+    printStats(label, pq);
+    free(ids);
+    int64CancellablePriorityQueueDestroy(pq);
+}
+
+int main(void) {
+    Int64CancellablePriorityQueue *pq =
+        int64CancellablePriorityQueueCreate(8, 0.5);
+    if (!pq) {
+        fprintf(stderr, "Failed to create priority queue\n");
+        return EXIT_FAILURE;
+    }
+
+    for (int64_t id = 1; id <= 10; id++)
+        int64CancellablePriorityQueuePush(pq, id * 10);
+    int64CancellablePriorityQueueCancel(pq, 100);
+    int64CancellablePriorityQueueCancel(pq, 90);
+    int64CancellablePriorityQueueCancel(pq, 40);
+    if (!int64CancellablePriorityQueueCancel(pq, 90))
+        printf("90 was already cancelled\n");
+    printStats("after cancelling 100, 90, 40", pq);
+    printf("Peek: %ld\n", int64CancellablePriorityQueuePeek(pq));
+    while (!int64CancellablePriorityQueueIsEmpty(pq))
+        printf("Popped %ld\n", int64CancellablePriorityQueuePop(pq));
+    printStats("drained", pq);
+    int64CancellablePriorityQueueDestroy(pq);
+
+    printf("\n10000 rounds of 1000 submits, 900 cancels, 80 dispatches:\n");
+    benchmark(0.25, 10000);
+    benchmark(0.5, 10000);
+    benchmark(1.0, 10000); // never purges: dead entries only leave via pops
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,419 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Slot sentinels. Key 0 and INT64_MIN are tracked by dedicated flags so that
+// every int64_t value can still be stored.
+#define SLOT_EMPTY ((int64_t)0)
+#define SLOT_MOVED INT64_MIN
+
+// Number of slots a thread claims at once while migrating to a larger table
+#define MIGRATION_CHUNK 1024
+
+// One generation of the open-addressing table. When it fills up, a table of
+// twice the capacity is published in `next`, and every thread that touches the
+// old table helps copy chunks of it before moving on.
+typedef struct ConcurrentSetTable {
+    _Atomic int64_t *slots;     // key words, SLOT_EMPTY or SLOT_MOVED
+    size_t capacity;            // number of slots (power of two)
+    size_t mask;                // capacity - 1
+    size_t maxCount;            // occupied slots allowed by the load factor
+    atomic_size_t count;        // occupied slots (including migrated keys)
+    atomic_size_t migrateNext;  // next chunk to claim for migration
+    atomic_bool *chunkDone;     // per chunk: completely migrated
+    _Atomic(struct ConcurrentSetTable *) next; // successor table, if resizing
+} ConcurrentSetTable;
+
+typedef struct {
+    _Atomic(ConcurrentSetTable *) table; // current table generation
+    ConcurrentSetTable *oldest;          // head of the generation chain
+    atomic_size_t size;                  // number of distinct keys
+    atomic_bool hasEmptyKey;             // key SLOT_EMPTY is in the set
+    atomic_bool hasMovedKey;             // key SLOT_MOVED is in the set
+    float loadFactor;
+} Int64ConcurrentSet;
+
+// Same mixer as Int64Set, so both sets distribute keys identically
+static inline uint64_t int64Hash(int64_t key) {
+    uint64_t x = (uint64_t)key;
+    x = ((x >> 30) ^ x) * 0xbf58476d1ce4e5b9ULL;
+    x = ((x >> 27) ^ x) * 0x94d049bb133111ebULL;
+    x = (x >> 31) ^ x;
+    return x;
+}
+
+// Round up to the next power of two (minimum 16)
+static size_t roundUpPowerOfTwo(size_t n) {
+    size_t p = 16;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+
+// Allocate a table generation. calloc() leaves every slot at SLOT_EMPTY.
+static ConcurrentSetTable *concurrentSetTableCreate(size_t capacity,
+                                                    float loadFactor) {
+    ConcurrentSetTable *t = calloc(1, sizeof(ConcurrentSetTable));
+    if (!t) {
+        fprintf(stderr, "Failed to allocate memory for ConcurrentSetTable\n");
+        return NULL;
+    }
+    t->slots = calloc(capacity, sizeof(*t->slots));
+    if (!t->slots) {
+        fprintf(stderr, "Failed to allocate memory for %zu slots\n", capacity);
+        free(t);
+        return NULL;
+    }
+    size_t chunks = (capacity + MIGRATION_CHUNK - 1) / MIGRATION_CHUNK;
+    t->chunkDone = calloc(chunks, sizeof(*t->chunkDone));
+    if (!t->chunkDone) {
+        fprintf(stderr, "Failed to allocate memory for %zu chunks\n", chunks);
+        free(t->slots);
+        free(t);
+        return NULL;
+    }
+    t->capacity = capacity;
+    t->mask = capacity - 1;
+    t->maxCount = (size_t)((double)capacity * loadFactor);
+    atomic_init(&t->count, 0);
+    atomic_init(&t->migrateNext, 0);
+    atomic_init(&t->next, NULL);
+    return t;
+}
+
+// Insert a key while migrating. Nobody inserts directly into a table whose
+// predecessor is still being copied, so plain CAS probing is enough here.
+// A sealed slot means `t` is itself being migrated, which only starts once
+// its predecessor is fully copied: a late helper's key is already in place.
+static void concurrentSetTablePlace(ConcurrentSetTable *t, int64_t key) {
+    size_t index = int64Hash(key) & t->mask;
+    while (true) {
+        int64_t expected = SLOT_EMPTY;
+        if (atomic_compare_exchange_strong(&t->slots[index], &expected, key)) {
+            atomic_fetch_add(&t->count, 1);
+            return;
+        }
+        if (expected == key || expected == SLOT_MOVED)
+            return;
+        index = (index + 1) & t->mask;
+    }
+}
+
+// Copy one chunk of `t` into `next` and seal its slots. Several helpers may
+// copy the same chunk at once: placing a key is idempotent and slots that
+// are already sealed are skipped.
+static void concurrentSetMigrateChunk(ConcurrentSetTable *t,
+                                      ConcurrentSetTable *next, size_t chunk) {
+    size_t begin = chunk * MIGRATION_CHUNK;
+    size_t end = begin + MIGRATION_CHUNK;
+    if (end > t->capacity)
+        end = t->capacity;
+
+    for (size_t i = begin; i < end; i++) {
+        int64_t key = atomic_load(&t->slots[i]);
+        // Seal the empty slot; if an inserter won the race, copy its key
+        if (key == SLOT_EMPTY &&
+            atomic_compare_exchange_strong(&t->slots[i], &key, SLOT_MOVED))
+            continue;
+        if (key == SLOT_MOVED)
+            continue;
+        // Keys never change once written, so copy then seal the slot
+        concurrentSetTablePlace(next, key);
+        atomic_store(&t->slots[i], SLOT_MOVED);
+    }
+    atomic_store(&t->chunkDone[chunk], true);
+}
+
+// Copy every chunk of `t` into `t->next`, claiming chunks with other helpers,
+// and publish the new table. Chunks claimed by others that are not done yet
+// are copied again here rather than waited for, so a stalled helper never
+// blocks the rest: the new table holds every old key when this returns.
+static void concurrentSetHelpMigrate(Int64ConcurrentSet *set,
+                                     ConcurrentSetTable *t) {
+    ConcurrentSetTable *next = atomic_load(&t->next);
+    size_t chunks = (t->capacity + MIGRATION_CHUNK - 1) / MIGRATION_CHUNK;
+
+    while (true) {
+        size_t chunk = atomic_fetch_add(&t->migrateNext, 1);
+        if (chunk >= chunks)
+            break;
+        concurrentSetMigrateChunk(t, next, chunk);
+    }
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        if (!atomic_load(&t->chunkDone[chunk]))
+            concurrentSetMigrateChunk(t, next, chunk);
+    }
+
+    ConcurrentSetTable *expected = t;
+    atomic_compare_exchange_strong(&set->table, &expected, next);
+}
+
+// Start (or join) a resize of table `t`. Returns false only if no successor
+// table could be allocated.
+static bool concurrentSetGrow(Int64ConcurrentSet *set, ConcurrentSetTable *t) {
+    if (!atomic_load(&t->next)) {
+        ConcurrentSetTable *bigger =
+            concurrentSetTableCreate(t->capacity * 2, set->loadFactor);
+        if (!bigger)
+            return false;
+        ConcurrentSetTable *expected = NULL;
+        if (!atomic_compare_exchange_strong(&t->next, &expected, bigger)) {
+            // Someone else published a successor first
+            free(bigger->chunkDone);
+            free(bigger->slots);
+            free(bigger);
+        }
+    }
+    concurrentSetHelpMigrate(set, t);
+    return true;
+}
+
+// Claim a flag that stands in for a sentinel-valued key
+static bool concurrentSetClaimFlag(Int64ConcurrentSet *set, atomic_bool *flag) {
+    if (atomic_load(flag) || atomic_exchange(flag, true))
+        return false;
+    atomic_fetch_add(&set->size, 1);
+    return true;
+}
+
+// Create a new Int64ConcurrentSet with the given capacity.
+Int64ConcurrentSet *int64ConcurrentSetCreate(size_t capacity,
+                                             float loadFactor) {
+    if (loadFactor <= 0.0f || loadFactor >= 1.0f) {
+        fprintf(stderr, "Invalid load factor: %f, only accept (0, 1)\n",
+                loadFactor);
+        return NULL;
+    }
+
+    Int64ConcurrentSet *set = calloc(1, sizeof(Int64ConcurrentSet));
+    if (!set) {
+        fprintf(stderr, "Failed to allocate memory for Int64ConcurrentSet\n");
+        return NULL;
+    }
+    set->loadFactor = loadFactor;
+
+    ConcurrentSetTable *t =
+        concurrentSetTableCreate(roundUpPowerOfTwo(capacity), loadFactor);
+    if (!t) {
+        free(set);
+        return NULL;
+    }
+    set->oldest = t;
+    atomic_init(&set->table, t);
+    atomic_init(&set->size, 0);
+    atomic_init(&set->hasEmptyKey, false);
+    atomic_init(&set->hasMovedKey, false);
+    return set;
+}
+
+// Insert a key into the set. Safe to call from any number of threads.
+// Return true if this call added the key, otherwise return false.
+// (including the case that the key already exists)
+bool int64ConcurrentSetInsert(Int64ConcurrentSet *set, int64_t key) {
+    if (key == SLOT_EMPTY)
+        return concurrentSetClaimFlag(set, &set->hasEmptyKey);
+    if (key == SLOT_MOVED)
+        return concurrentSetClaimFlag(set, &set->hasMovedKey);
+
+    ConcurrentSetTable *t = atomic_load(&set->table);
+    while (true) {
+        // Never insert into a table that is being migrated
+        if (atomic_load(&t->next)) {
+            concurrentSetHelpMigrate(set, t);
+            t = atomic_load(&t->next);
+            continue;
+        }
+        if (atomic_load(&t->count) + 1 > t->maxCount) {
+            if (!concurrentSetGrow(set, t))
+                return false;
+            t = atomic_load(&t->next);
+            continue;
+        }
+
+        size_t index = int64Hash(key) & t->mask;
+        bool moved = false;
+        for (size_t i = 0; i < t->capacity; i++) {
+            _Atomic int64_t *slot = &t->slots[index];
+            int64_t current = atomic_load(slot);
+
+            if (current == SLOT_EMPTY) {
+                if (atomic_compare_exchange_strong(slot, &current, key)) {
+                    atomic_fetch_add(&t->count, 1);
+                    atomic_fetch_add(&set->size, 1);
+                    return true;
+                }
+                // Lost the race; `current` now holds the winner's word
+            }
+            if (current == key)
+                return false;
+            if (current == SLOT_MOVED) {
+                moved = true;
+                break;
+            }
+            index = (index + 1) & t->mask;
+        }
+
+        // Either migration sealed our probe path or the table is full
+        if (!moved && !concurrentSetGrow(set, t))
+            return false;
+        if (moved)
+            concurrentSetHelpMigrate(set, t);
+        t = atomic_load(&t->next);
+    }
+}
+
+// Check if the key exists in the set. Wait-free: it never blocks on a
+// migration, it only follows sealed slots into the successor table.
+bool int64ConcurrentSetContains(Int64ConcurrentSet *set, int64_t key) {
+    if (key == SLOT_EMPTY)
+        return atomic_load(&set->hasEmptyKey);
+    if (key == SLOT_MOVED)
+        return atomic_load(&set->hasMovedKey);
+
+    ConcurrentSetTable *t = atomic_load(&set->table);
+    while (t) {
+        size_t index = int64Hash(key) & t->mask;
+        size_t i = 0;
+        for (; i < t->capacity; i++) {
+            int64_t current = atomic_load(&t->slots[index]);
+            if (current == key)
+                return true;
+            if (current == SLOT_EMPTY)
+                return false;
+            if (current == SLOT_MOVED)
+                break;
+            index = (index + 1) & t->mask;
+        }
+        // A sealed slot (or a full probe) means newer keys live further on
+        t = atomic_load(&t->next);
+    }
+    return false;
+}
+
+// Get the current number of keys in the set.
+size_t int64ConcurrentSetSize(Int64ConcurrentSet *set) {
+    return atomic_load(&set->size);
+}
+
+// Destroy the Int64ConcurrentSet and free all memory.
+// Old table generations are kept until here since lock-free readers may still
+// be probing them; the caller must ensure no thread uses the set anymore.
+void int64ConcurrentSetDestroy(Int64ConcurrentSet *set) {
+    if (!set)
+        return;
+    ConcurrentSetTable *t = set->oldest;
+    while (t) {
+        ConcurrentSetTable *next = atomic_load(&t->next);
+        free(t->chunkDone);
+        free(t->slots);
+        free(t);
+        t = next;
+    }
+    free(set);
+}
+
+// ---------------------------------------------------------------------------
+// Multi-threaded dedup benchmark
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    Int64ConcurrentSet *set;
+    pthread_mutex_t *lock; // non-NULL to emulate the global-mutex wrapper
+    size_t threadId;
+    size_t operations;
+    size_t keySpace;  // keys are drawn from [1, keySpace], causing duplicates
+    size_t inserted;  // number of inserts that returned true
+} DedupWorker;
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Every 4th operation is a lookup, the rest are inserts
+static void *dedupWorkerRun(void *arg) {
+    DedupWorker *w = arg;
+    uint64_t state = 0x9e3779b97f4a7c15ULL * (w->threadId + 1);
+    for (size_t i = 0; i < w->operations; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int64_t key = (int64_t)(state % w->keySpace) + 1;
+
+        if (w->lock)
+            pthread_mutex_lock(w->lock);
+        if (i % 4 == 3)
+            (void)int64ConcurrentSetContains(w->set, key);
+        else if (int64ConcurrentSetInsert(w->set, key))
+            w->inserted++;
+        if (w->lock)
+            pthread_mutex_unlock(w->lock);
+    }
+    return NULL;
+}
+
+static void runDedupBenchmark(size_t threads, size_t operations,
+                              size_t keySpace, bool useMutex) {
+    Int64ConcurrentSet *set = int64ConcurrentSetCreate(1024, 0.5f);
+    if (!set)
+        return;
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    pthread_t tids[64];
+    DedupWorker workers[64];
+
+    double start = nowSeconds();
+    for (size_t t = 0; t < threads; t++) {
+        workers[t] = (DedupWorker){set, useMutex ? &lock : NULL, t,
+                                   operations / threads, keySpace, 0};
+        pthread_create(&tids[t], NULL, dedupWorkerRun, &workers[t]);
+    }
+    size_t inserted = 0;
+    for (size_t t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+        inserted += workers[t].inserted;
+    }
+    double elapsed = nowSeconds() - start;
+
+    printf("%-10s threads=%2zu  %8.2f Mops/s  distinct=%zu  inserted=%zu%s\n",
+           useMutex ? "mutex" : "lock-free", threads,
+           (double)operations / elapsed / 1e6, int64ConcurrentSetSize(set),
+           inserted,
+           inserted == int64ConcurrentSetSize(set) ? "" : "  MISMATCH");
+    int64ConcurrentSetDestroy(set);
+}
+
+// Example usage.
+int main(void) {
+    Int64ConcurrentSet *set = int64ConcurrentSetCreate(16, 0.75f);
+    if (!set) {
+        fprintf(stderr, "Failed to create Int64ConcurrentSet\n");
+        return 1;
+    }
+
+    // Sentinel-valued keys are regular members from the caller's view
+    printf("=== Inserting keys -5 to 99 (includes 0 and INT64_MIN) ===\n");
+    int64ConcurrentSetInsert(set, INT64_MIN);
+    for (int64_t i = -5; i < 100; i++)
+        int64ConcurrentSetInsert(set, i);
+    printf("Set size: %zu\n", int64ConcurrentSetSize(set));
+    printf("Duplicate 42 inserted: %d\n", int64ConcurrentSetInsert(set, 42));
+    printf("Contains 0: %d, INT64_MIN: %d, 100: %d\n",
+           int64ConcurrentSetContains(set, 0),
+           int64ConcurrentSetContains(set, INT64_MIN),
+           int64ConcurrentSetContains(set, 100));
+    int64ConcurrentSetDestroy(set);
+
+    // Each inserted key must be reported as new by exactly one thread
+    printf("\n=== Dedup benchmark: 4M ops, 1M distinct keys ===\n");
+    size_t threadCounts[] = {1, 2, 4, 8};
+    for (size_t i = 0; i < sizeof(threadCounts) / sizeof(*threadCounts); i++) {
+        runDedupBenchmark(threadCounts[i], 4000000, 1000000, true);
+        runDedupBenchmark(threadCounts[i], 4000000, 1000000, false);
+    }
+    return 0;
+}
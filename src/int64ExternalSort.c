@@ -0,0 +1,457 @@
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Smallest read buffer a run gets during a merge; fixes the maximum fan-in
+// for a given memory budget (more runs than that are merged in several passes)
+#define MIN_RUN_BUFFER_BYTES (1u << 20)
+
+// Sort statistics
+typedef struct {
+    size_t values;      // number of int64_t values sorted
+    size_t runs;        // sorted runs produced by the first phase
+    size_t mergePasses; // merge passes over the data
+    double runSeconds;
+    double mergeSeconds;
+} ExternalSortStats;
+
+// ---------------------------------------------------------------------------
+// Run generation: in-memory heap sort
+// ---------------------------------------------------------------------------
+
+// Restore the max heap property downward from index i (as in Int64MaxHeap)
+static void heapifyDown(int64_t *data, size_t size, size_t i) {
+    int64_t value = data[i];
+    while (true) {
+        size_t child = 2 * i + 1;
+        if (child >= size)
+            break;
+        if (child + 1 < size && data[child + 1] > data[child])
+            child++;
+        if (data[child] <= value)
+            break;
+        data[i] = data[child];
+        i = child;
+    }
+    data[i] = value;
+}
+
+// Sort ascending: Floyd heapify, then move the max to the end repeatedly
+static void heapSort(int64_t *data, size_t size) {
+    if (size < 2)
+        return;
+    for (size_t i = (size - 2) / 2 + 1; i-- > 0;)
+        heapifyDown(data, size, i);
+    for (size_t end = size - 1; end > 0; end--) {
+        int64_t max = data[0];
+        data[0] = data[end];
+        data[end] = max;
+        heapifyDown(data, end, 0);
+    }
+}
+
+// Write `count` values, reporting any short write
+static bool writeAll(FILE *file, const int64_t *values, size_t count) {
+    if (fwrite(values, sizeof(int64_t), count, file) != count) {
+        perror("fwrite");
+        return false;
+    }
+    return true;
+}
+
+// Run files live in a directory private to one sort (see int64ExternalSort),
+// so sorts sharing a temporary directory never see each other's runs
+static void runPath(char *path, size_t size, const char *sortDir,
+                    size_t pass, size_t index) {
+    snprintf(path, size, "%s/int64-run-%zu-%zu.bin", sortDir, pass, index);
+}
+
+// Remove run files 0 .. count - 1 of `pass`
+static void removeRuns(const char *sortDir, size_t pass, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        char path[4096];
+        runPath(path, sizeof(path), sortDir, pass, i);
+        remove(path);
+    }
+}
+
+// Read the input in budget-sized chunks, sort each in memory and write it to
+// its own run file. Stores the number of runs (0 for an empty input) and
+// values. Returns false on failure, after removing the runs written so far.
+static bool generateRuns(const char *inputPath, const char *sortDir,
+                         size_t memoryBudget, size_t *runs, size_t *values) {
+    *runs = 0;
+    *values = 0;
+    FILE *input = fopen(inputPath, "rb");
+    if (!input) {
+        perror(inputPath);
+        return false;
+    }
+    posix_fadvise(fileno(input), 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    size_t capacity = memoryBudget / sizeof(int64_t);
+    int64_t *chunk = malloc(capacity * sizeof(int64_t));
+    if (!chunk) {
+        fprintf(stderr, "Failed to allocate the %zu byte sort buffer\n",
+                memoryBudget);
+        fclose(input);
+        return false;
+    }
+
+    bool ok = true;
+    while (true) {
+        size_t count = fread(chunk, sizeof(int64_t), capacity, input);
+        if (count < capacity && ferror(input)) {
+            perror(inputPath);
+            ok = false;
+            break;
+        }
+        if (count == 0)
+            break;
+        heapSort(chunk, count);
+
+        char path[4096];
+        runPath(path, sizeof(path), sortDir, 0, *runs);
+        FILE *run = fopen(path, "wb");
+        // Count the run before writing it so a partial file is removed too
+        if (run)
+            (*runs)++;
+        bool written = run && writeAll(run, chunk, count);
+        if (run && fclose(run) != 0)
+            written = false;
+        if (!written) {
+            perror(path);
+            ok = false;
+            break;
+        }
+        *values += count;
+    }
+
+    free(chunk);
+    fclose(input);
+    if (!ok) {
+        removeRuns(sortDir, 0, *runs);
+        *runs = 0;
+    }
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// k-way merge through a loser tree
+// ---------------------------------------------------------------------------
+
+// Sequential reader over one run with a large private buffer
+typedef struct {
+    FILE *file;
+    int64_t *buffer;
+    size_t capacity; // buffer size in values
+    size_t count;    // values currently in the buffer
+    size_t pos;      // next value to hand out
+    off_t offset;    // file offset of the next read
+    bool exhausted;
+    bool failed; // a read error ended the run early
+} RunReader;
+
+// Refill a reader's buffer and hint the kernel to prefetch the next one
+static void runReaderRefill(RunReader *r) {
+    r->count = fread(r->buffer, sizeof(int64_t), r->capacity, r->file);
+    r->pos = 0;
+    r->offset += (off_t)(r->count * sizeof(int64_t));
+    if (r->count == 0) {
+        r->exhausted = true;
+        r->failed = ferror(r->file) != 0;
+        return;
+    }
+    posix_fadvise(fileno(r->file), r->offset,
+                  (off_t)(r->capacity * sizeof(int64_t)), POSIX_FADV_WILLNEED);
+}
+
+static inline int64_t runReaderHead(const RunReader *r) {
+    return r->buffer[r->pos];
+}
+
+static inline void runReaderAdvance(RunReader *r) {
+    if (++r->pos == r->count)
+        runReaderRefill(r);
+}
+
+// Does run a's head come before run b's? Exhausted runs lose every game.
+static inline bool runBefore(const RunReader *readers, size_t a, size_t b) {
+    if (readers[a].exhausted)
+        return false;
+    if (readers[b].exhausted)
+        return true;
+    int64_t x = runReaderHead(&readers[a]);
+    int64_t y = runReaderHead(&readers[b]);
+    return x < y || (x == y && a < b);
+}
+
+// Loser tree over k runs: leaf i sits at node k + i, internal nodes 1..k-1
+// hold the loser of the game played there and tree[0] holds the overall
+// winner. Replacing the winner replays only its leaf-to-root path, one
+// comparison per level against a compact array of k indices.
+typedef struct {
+    size_t *tree;
+    size_t k;
+} LoserTree;
+
+static bool loserTreeBuild(LoserTree *lt, const RunReader *readers,
+                           size_t k) {
+    lt->k = k;
+    lt->tree = malloc(k * sizeof(size_t));
+    size_t *winners = malloc(2 * k * sizeof(size_t));
+    if (!lt->tree || !winners) {
+        fprintf(stderr, "Failed to allocate the loser tree\n");
+        free(lt->tree);
+        free(winners);
+        return false;
+    }
+    for (size_t i = 0; i < k; i++)
+        winners[k + i] = i;
+    for (size_t n = k - 1; n >= 1; n--) {
+        size_t a = winners[2 * n], b = winners[2 * n + 1];
+        bool aWins = runBefore(readers, a, b);
+        winners[n] = aWins ? a : b;
+        lt->tree[n] = aWins ? b : a;
+    }
+    lt->tree[0] = k > 1 ? winners[1] : 0;
+    free(winners);
+    return true;
+}
+
+// Replay the path of leaf `run` after its head changed
+static inline void loserTreeReplay(LoserTree *lt, const RunReader *readers,
+                                   size_t run) {
+    size_t winner = run;
+    for (size_t n = (lt->k + run) / 2; n >= 1; n /= 2) {
+        if (runBefore(readers, lt->tree[n], winner)) {
+            size_t loser = winner;
+            winner = lt->tree[n];
+            lt->tree[n] = loser;
+        }
+    }
+    lt->tree[0] = winner;
+}
+
+// Merge runs [first, first + k) of `pass` into `outputPath`. The input runs
+// are removed either way; on failure the partial output is removed too.
+static bool mergeRuns(const char *sortDir, size_t pass, size_t first,
+                      size_t k, const char *outputPath, size_t memoryBudget) {
+    // One buffer per input run plus one for the output
+    size_t bufferValues = memoryBudget / (k + 1) / sizeof(int64_t);
+    RunReader *readers = calloc(k, sizeof(RunReader));
+    int64_t *out = malloc(bufferValues * sizeof(int64_t));
+    FILE *output = fopen(outputPath, "wb");
+    bool ok = readers && out && output;
+    if (!ok)
+        fprintf(stderr, "Failed to set up the merge into %s\n", outputPath);
+
+    for (size_t i = 0; ok && i < k; i++) {
+        char path[4096];
+        runPath(path, sizeof(path), sortDir, pass, first + i);
+        readers[i].file = fopen(path, "rb");
+        readers[i].buffer = malloc(bufferValues * sizeof(int64_t));
+        readers[i].capacity = bufferValues;
+        if (!readers[i].file || !readers[i].buffer) {
+            perror(path);
+            ok = false;
+            break;
+        }
+        posix_fadvise(fileno(readers[i].file), 0, 0, POSIX_FADV_SEQUENTIAL);
+        runReaderRefill(&readers[i]);
+    }
+
+    LoserTree lt = {NULL, 0};
+    if (ok)
+        ok = loserTreeBuild(&lt, readers, k);
+
+    size_t buffered = 0;
+    while (ok && !readers[lt.tree[0]].exhausted) {
+        size_t winner = lt.tree[0];
+        out[buffered++] = runReaderHead(&readers[winner]);
+        if (buffered == bufferValues) {
+            ok = writeAll(output, out, buffered);
+            buffered = 0;
+        }
+        runReaderAdvance(&readers[winner]);
+        loserTreeReplay(&lt, readers, winner);
+    }
+    if (ok && buffered > 0)
+        ok = writeAll(output, out, buffered);
+
+    for (size_t i = 0; readers && i < k; i++) {
+        if (readers[i].failed) {
+            fprintf(stderr, "Read error in run %zu of pass %zu\n", first + i,
+                    pass);
+            ok = false;
+        }
+        if (readers[i].file)
+            fclose(readers[i].file);
+        free(readers[i].buffer);
+        char path[4096];
+        runPath(path, sizeof(path), sortDir, pass, first + i);
+        remove(path);
+    }
+    if (output && fclose(output) != 0)
+        ok = false;
+    if (!ok && output)
+        remove(outputPath);
+    free(lt.tree);
+    free(readers);
+    free(out);
+    return ok;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Sort a file of native-endian int64_t values into `outputPath` using at most
+// about `memoryBudget` bytes of buffers. Run files are created in a private
+// directory under `tempDir` and removed as soon as they are merged; on
+// failure every run, the directory and any partial output are removed.
+// Return true on success.
+bool int64ExternalSort(const char *inputPath, const char *outputPath,
+                       const char *tempDir, size_t memoryBudget,
+                       ExternalSortStats *stats) {
+    if (memoryBudget < 2 * MIN_RUN_BUFFER_BYTES) {
+        fprintf(stderr, "Memory budget must be at least %u bytes\n",
+                2 * MIN_RUN_BUFFER_BYTES);
+        return false;
+    }
+    char sortDir[4000];
+    snprintf(sortDir, sizeof(sortDir), "%s/int64-sort-XXXXXX", tempDir);
+    if (!mkdtemp(sortDir)) {
+        perror(sortDir);
+        return false;
+    }
+    ExternalSortStats local = {0};
+
+    double start = nowSeconds();
+    size_t runs;
+    if (!generateRuns(inputPath, sortDir, memoryBudget, &runs,
+                      &local.values)) {
+        rmdir(sortDir);
+        return false;
+    }
+    local.runSeconds = nowSeconds() - start;
+    local.runs = runs;
+    if (runs == 0) {
+        // Empty input sorts to an empty file
+        rmdir(sortDir);
+        FILE *output = fopen(outputPath, "wb");
+        if (!output || fclose(output) != 0) {
+            perror(outputPath);
+            return false;
+        }
+        if (stats)
+            *stats = local;
+        return true;
+    }
+
+    // Merge passes until a single run remains; the last pass writes output
+    size_t maxFanIn = memoryBudget / MIN_RUN_BUFFER_BYTES - 1;
+    size_t pass = 0;
+    start = nowSeconds();
+    while (true) {
+        size_t groups = (runs + maxFanIn - 1) / maxFanIn;
+        for (size_t g = 0; g < groups; g++) {
+            size_t first = g * maxFanIn;
+            size_t k = runs - first < maxFanIn ? runs - first : maxFanIn;
+            char next[4096];
+            runPath(next, sizeof(next), sortDir, pass + 1, g);
+            if (!mergeRuns(sortDir, pass, first, k,
+                           groups == 1 ? outputPath : next, memoryBudget)) {
+                // Drop the unmerged runs of this pass and the finished
+                // groups of the next one
+                removeRuns(sortDir, pass, runs);
+                removeRuns(sortDir, pass + 1, g);
+                rmdir(sortDir);
+                return false;
+            }
+        }
+        pass++;
+        runs = groups;
+        if (groups == 1)
+            break;
+    }
+    rmdir(sortDir);
+    local.mergePasses = pass;
+    local.mergeSeconds = nowSeconds() - start;
+    if (stats)
+        *stats = local;
+    return true;
+}
+
+// Example usage: sort a file 4x larger than the memory budget
+int main(void) {
+    const char *inputPath = "int64-external-input.bin";
+    const char *outputPath = "int64-external-output.bin";
+    size_t values = 32 * 1024 * 1024; // 256 MB
+    size_t memoryBudget = 64u << 20;  // 64 MB
+
+    FILE *input = fopen(inputPath, "wb");
+    if (!input) {
+        perror(inputPath);
+        return EXIT_FAILURE;
+    }
+    size_t blockValues = 1 << 20;
+    int64_t *block = malloc(blockValues * sizeof(int64_t));
+    uint64_t state = 88172645463325252ULL;
+    for (size_t written = 0; written < values; written += blockValues) {
+        for (size_t i = 0; i < blockValues; i++) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            block[i] = (int64_t)state;
+        }
+        writeAll(input, block, blockValues);
+    }
+    fclose(input);
+
+    ExternalSortStats stats;
+    if (!int64ExternalSort(inputPath, outputPath, ".", memoryBudget, &stats)) {
+        fprintf(stderr, "External sort failed\n");
+        return EXIT_FAILURE;
+    }
+
+    // Verify the output streams in ascending order
+    FILE *output = fopen(outputPath, "rb");
+    bool sorted = output != NULL;
+    size_t checked = 0;
+    int64_t previous = INT64_MIN;
+    size_t count;
+    while (output && (count = fread(block, sizeof(int64_t), blockValues,
+                                    output)) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            sorted &= block[i] >= previous;
+            previous = block[i];
+        }
+        checked += count;
+    }
+    if (output)
+        fclose(output);
+
+    double megabytes = (double)(stats.values * sizeof(int64_t)) / 1e6;
+    printf("Sorted %zu values (%.0f MB) with a %zu MB budget\n", stats.values,
+           megabytes, memoryBudget >> 20);
+    printf("run generation: %zu runs, %.2f s (%.0f MB/s)\n", stats.runs,
+           stats.runSeconds, megabytes / stats.runSeconds);
+    printf("merge: %zu pass(es), %.2f s (%.0f MB/s)\n", stats.mergePasses,
+           stats.mergeSeconds, megabytes / stats.mergeSeconds);
+    printf("output %s\n",
+           sorted && checked == values ? "sorted" : "NOT SORTED");
+
+    free(block);
+    remove(inputPath);
+    remove(outputPath);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,691 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <emmintrin.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_KERNELS 1
+#endif
+
+// Structure to hold the dynamic integer array (as in integerDynamicArray.c)
+typedef struct {
+    int *data;       // Pointer to the array holding the data
+    size_t size;     // Current number of elements in the array
+    size_t capacity; // Current capacity of the array (adjustable)
+} IntegerDynamicArray;
+
+// Values per compressed block
+#define FROZEN_BLOCK 128
+// Widest bit-packed residual; higher bits go to exceptions
+#define FROZEN_MAX_BITS 32
+
+typedef enum {
+    FROZEN_FOR,   // value = min + residual
+    FROZEN_DELTA, // value = previous + minDelta + residual (first: min + r)
+    FROZEN_RAW,   // 128 plain values (incompressible block)
+} FrozenBlockMode;
+
+// Block directory entry, 16 bytes per 128 values. min and rangeBits double as
+// a zone map that lets searches skip blocks without decoding them. Per-block
+// fields that only some blocks need live in header words in front of their
+// packed data: minDelta (delta blocks), then the exception offset (blocks
+// with exceptions).
+typedef struct {
+    int64_t min;            // smallest value, base of every residual
+    uint32_t offset;        // offset in packed (words) or raw (blocks)
+    uint8_t bits;           // packed residual width (0..32)
+    uint8_t mode;           // FrozenBlockMode
+    uint8_t exceptionCount;
+    uint8_t rangeBits;      // bit length of max - min (zone map bound)
+} FrozenBlock;
+
+// Read-only compressed int64_t array (patched frame-of-reference).
+// Each block of 128 values is stored either relative to its minimum (FOR) or
+// as steps between neighbours (delta, for sorted or nearly sorted data),
+// whichever is smaller, or as plain values when neither beats 64 bits.
+// Residuals are bit-packed at a per-block width chosen to minimise size; the
+// few residuals that do not fit keep their low bits in place and their high
+// bits in a patch list ("exceptions"), so one outlier does not widen the
+// whole block. Packing is vertical (value i in 32-bit lane
+// i % 4), so a block unpacks four values per SSE2 instruction.
+typedef struct {
+    FrozenBlock *blocks;
+    size_t blockCount;
+    size_t size;                 // number of values
+    uint32_t *packed;            // bit-packed residual lows
+    size_t packedWords;          // used 32-bit words in packed
+    uint8_t *exceptionPositions; // position in block of each exception
+    uint64_t *exceptionHighs;    // high residual bits of each exception
+    size_t exceptionCount;       // used entries of the exception arrays
+    int64_t *raw;                // values of raw blocks, stored as is
+    size_t rawCount;             // used entries of raw
+} Int64FrozenArray;
+
+// Number of significant bits of x (0 for 0)
+static inline unsigned bitLength(uint64_t x) {
+    return x == 0 ? 0 : 64 - (unsigned)__builtin_clzll(x);
+}
+
+// Choose the packed width minimising size: 16 bytes per bit of width plus
+// 9 bytes (position and high bits) per exception. Return the byte cost.
+static size_t chooseBits(const uint64_t *residuals, unsigned *bits) {
+    size_t histogram[65] = {0};
+    for (int i = 0; i < FROZEN_BLOCK; i++)
+        histogram[bitLength(residuals[i])]++;
+    size_t bestCost = SIZE_MAX;
+    size_t above = 0; // residuals longer than b bits
+    for (unsigned b = 64; b-- > 0;) {
+        above += histogram[b + 1];
+        if (b > FROZEN_MAX_BITS)
+            continue;
+        size_t cost = 16 * b + 9 * above;
+        if (cost <= bestCost) {
+            bestCost = cost;
+            *bits = b;
+        }
+    }
+    return bestCost;
+}
+
+// Append `count` entries of room to the exception arrays
+static bool reserveExceptions(Int64FrozenArray *fa, size_t *capacity,
+                              size_t count) {
+    if (fa->exceptionCount + count <= *capacity)
+        return true;
+    size_t newCapacity = *capacity ? *capacity : 1024;
+    while (newCapacity < fa->exceptionCount + count)
+        newCapacity *= 2;
+    uint8_t *positions = realloc(fa->exceptionPositions, newCapacity);
+    if (positions)
+        fa->exceptionPositions = positions;
+    uint64_t *highs =
+        realloc(fa->exceptionHighs, newCapacity * sizeof(uint64_t));
+    if (highs)
+        fa->exceptionHighs = highs;
+    if (!positions || !highs) {
+        fprintf(stderr, "Memory (re)allocation failed for exceptions\n");
+        return false;
+    }
+    *capacity = newCapacity;
+    return true;
+}
+
+// Append `count` entries of room to the raw value array
+static bool reserveRaw(Int64FrozenArray *fa, size_t *capacity, size_t count) {
+    if (fa->rawCount + count <= *capacity)
+        return true;
+    size_t newCapacity = *capacity ? *capacity : 1024;
+    while (newCapacity < fa->rawCount + count)
+        newCapacity *= 2;
+    int64_t *raw = realloc(fa->raw, newCapacity * sizeof(int64_t));
+    if (!raw) {
+        fprintf(stderr, "Memory (re)allocation failed for raw blocks\n");
+        return false;
+    }
+    fa->raw = raw;
+    *capacity = newCapacity;
+    return true;
+}
+
+// Pack the low `bits` bits of 128 residuals vertically: value i goes to lane
+// i % 4 at bit (i / 4) * bits of that lane's stream of `bits` 32-bit words
+static void packBlock(uint32_t *out, const uint64_t *residuals,
+                      unsigned bits) {
+    memset(out, 0, 4 * bits * sizeof(uint32_t));
+    uint64_t mask = bits == 64 ? ~0ULL : (1ULL << bits) - 1;
+    for (int i = 0; i < FROZEN_BLOCK; i++) {
+        unsigned lane = i % 4;
+        unsigned bit = (unsigned)(i / 4) * bits;
+        uint64_t low = residuals[i] & mask;
+        unsigned word = bit / 32, offset = bit % 32;
+        out[4 * word + lane] |= (uint32_t)(low << offset);
+        if (offset + bits > 32)
+            out[4 * (word + 1) + lane] |= (uint32_t)(low >> (32 - offset));
+    }
+}
+
+// Unpack 128 vertically packed residual lows of a fixed width with SSE2.
+// Inlined once per width so that every shift is a constant and the loop
+// fully unrolls.
+static inline __attribute__((always_inline)) void
+unpackFixed(uint32_t *out, const uint32_t *in, const unsigned bits) {
+    const __m128i *words = (const __m128i *)in;
+    const __m128i mask =
+        _mm_set1_epi32(bits == 32 ? -1 : (int)((1u << bits) - 1));
+    __m128i current = _mm_loadu_si128(words++);
+    unsigned shift = 0;
+    for (int i = 0; i < FROZEN_BLOCK / 4; i++) {
+        __m128i v = _mm_srli_epi32(current, shift);
+        shift += bits;
+        if (shift >= 32) {
+            shift -= 32;
+            if (i + 1 < FROZEN_BLOCK / 4 || shift > 0)
+                current = _mm_loadu_si128(words++);
+            if (shift > 0)
+                v = _mm_or_si128(v, _mm_slli_epi32(current, bits - shift));
+        }
+        _mm_storeu_si128((__m128i *)(out + 4 * i), _mm_and_si128(v, mask));
+    }
+}
+
+// Unpack 128 vertically packed residual lows of width `bits`
+static void unpackBlock(uint32_t *out, const uint32_t *in, unsigned bits) {
+    switch (bits) {
+    case 0:
+        memset(out, 0, FROZEN_BLOCK * sizeof(uint32_t));
+        break;
+#define UNPACK_CASE(b)                                                         \
+    case b:                                                                    \
+        unpackFixed(out, in, b);                                               \
+        break;
+        UNPACK_CASE(1) UNPACK_CASE(2) UNPACK_CASE(3) UNPACK_CASE(4)
+        UNPACK_CASE(5) UNPACK_CASE(6) UNPACK_CASE(7) UNPACK_CASE(8)
+        UNPACK_CASE(9) UNPACK_CASE(10) UNPACK_CASE(11) UNPACK_CASE(12)
+        UNPACK_CASE(13) UNPACK_CASE(14) UNPACK_CASE(15) UNPACK_CASE(16)
+        UNPACK_CASE(17) UNPACK_CASE(18) UNPACK_CASE(19) UNPACK_CASE(20)
+        UNPACK_CASE(21) UNPACK_CASE(22) UNPACK_CASE(23) UNPACK_CASE(24)
+        UNPACK_CASE(25) UNPACK_CASE(26) UNPACK_CASE(27) UNPACK_CASE(28)
+        UNPACK_CASE(29) UNPACK_CASE(30) UNPACK_CASE(31) UNPACK_CASE(32)
+#undef UNPACK_CASE
+    }
+}
+
+// Encode one block of 128 values (the last block is padded by the caller)
+static bool encodeBlock(Int64FrozenArray *fa, size_t *exceptionCapacity,
+                        size_t *rawCapacity, FrozenBlock *block,
+                        const int64_t *values) {
+    int64_t min = values[0], max = values[0];
+    int64_t minStep = INT64_MAX;
+    for (int i = 1; i < FROZEN_BLOCK; i++) {
+        if (values[i] < min)
+            min = values[i];
+        if (values[i] > max)
+            max = values[i];
+        // Steps are taken as signed so that small backward steps stay small
+        int64_t step = (int64_t)((uint64_t)values[i] - (uint64_t)values[i - 1]);
+        if (step < minStep)
+            minStep = step;
+    }
+    // minDelta is kept in 32 bits: larger steps leave a larger residual, and
+    // blocks stepping back further than that are left to FOR
+    int32_t minDelta = minStep > INT32_MAX ? INT32_MAX : (int32_t)minStep;
+
+    uint64_t forResiduals[FROZEN_BLOCK], deltaResiduals[FROZEN_BLOCK];
+    deltaResiduals[0] = (uint64_t)values[0] - (uint64_t)min;
+    for (int i = 0; i < FROZEN_BLOCK; i++) {
+        forResiduals[i] = (uint64_t)values[i] - (uint64_t)min;
+        if (i > 0)
+            deltaResiduals[i] = (uint64_t)values[i] - (uint64_t)values[i - 1] -
+                                (uint64_t)(int64_t)minDelta;
+    }
+    unsigned forBits, deltaBits = 0;
+    size_t forCost = chooseBits(forResiduals, &forBits);
+    size_t deltaCost = minStep < INT32_MIN
+                           ? SIZE_MAX
+                           : chooseBits(deltaResiduals, &deltaBits) +
+                                 sizeof(uint32_t);
+
+    *block = (FrozenBlock){min, (uint32_t)fa->packedWords, 0, FROZEN_FOR, 0,
+                           (uint8_t)bitLength((uint64_t)max - (uint64_t)min)};
+    if (forCost >= FROZEN_BLOCK * sizeof(int64_t) &&
+        deltaCost >= FROZEN_BLOCK * sizeof(int64_t)) {
+        // Incompressible: 64 bits per value plus the directory entry
+        block->mode = FROZEN_RAW;
+        block->offset = (uint32_t)(fa->rawCount / FROZEN_BLOCK);
+        if (!reserveRaw(fa, rawCapacity, FROZEN_BLOCK))
+            return false;
+        memcpy(&fa->raw[fa->rawCount], values, FROZEN_BLOCK * sizeof(int64_t));
+        fa->rawCount += FROZEN_BLOCK;
+        return true;
+    }
+
+    const uint64_t *residuals = forResiduals;
+    unsigned bits = forBits;
+    if (deltaCost < forCost) {
+        block->mode = FROZEN_DELTA;
+        residuals = deltaResiduals;
+        bits = deltaBits;
+    }
+    block->bits = (uint8_t)bits;
+
+    uint32_t *words = &fa->packed[fa->packedWords];
+    if (block->mode == FROZEN_DELTA)
+        *words++ = (uint32_t)minDelta;
+    for (int i = 0; i < FROZEN_BLOCK; i++) {
+        if (bitLength(residuals[i]) > bits)
+            block->exceptionCount++;
+    }
+    if (block->exceptionCount > 0) {
+        *words++ = (uint32_t)fa->exceptionCount;
+        if (!reserveExceptions(fa, exceptionCapacity, block->exceptionCount))
+            return false;
+    }
+    packBlock(words, residuals, bits);
+    fa->packedWords = (size_t)(words - fa->packed) + 4 * bits;
+
+    for (int i = 0; i < FROZEN_BLOCK; i++) {
+        if (bitLength(residuals[i]) <= bits)
+            continue;
+        fa->exceptionPositions[fa->exceptionCount] = (uint8_t)i;
+        fa->exceptionHighs[fa->exceptionCount] = residuals[i] >> bits;
+        fa->exceptionCount++;
+    }
+    return true;
+}
+
+// Destroy the frozen array memory
+void int64FrozenArrayDestroy(Int64FrozenArray *fa) {
+    if (!fa)
+        return;
+    free(fa->blocks);
+    free(fa->packed);
+    free(fa->exceptionPositions);
+    free(fa->exceptionHighs);
+    free(fa->raw);
+    free(fa);
+}
+
+// Compress n int64_t values into a new frozen array.
+Int64FrozenArray *int64FrozenArrayCreate(const int64_t *values, size_t n) {
+    Int64FrozenArray *fa = calloc(1, sizeof(*fa));
+    if (!fa) {
+        fprintf(stderr, "Memory allocation failed for Int64FrozenArray\n");
+        return NULL;
+    }
+    fa->size = n;
+    fa->blockCount = (n + FROZEN_BLOCK - 1) / FROZEN_BLOCK;
+    // Worst case: every block packed at the maximum width plus two header
+    // words; offsets into packed must fit the 32-bit directory field
+    size_t worstWords = 4 * FROZEN_MAX_BITS + 2;
+    if (fa->blockCount > UINT32_MAX / worstWords) {
+        fprintf(stderr, "Too many values for Int64FrozenArray: %zu\n", n);
+        free(fa);
+        return NULL;
+    }
+    fa->blocks = calloc(fa->blockCount ? fa->blockCount : 1,
+                        sizeof(FrozenBlock));
+    fa->packed =
+        malloc((fa->blockCount * worstWords + 1) * sizeof(uint32_t));
+    if (!fa->blocks || !fa->packed) {
+        fprintf(stderr, "Memory allocation failed for Int64FrozenArray\n");
+        int64FrozenArrayDestroy(fa);
+        return NULL;
+    }
+
+    size_t exceptionCapacity = 0, rawCapacity = 0;
+    int64_t padded[FROZEN_BLOCK];
+    for (size_t b = 0; b < fa->blockCount; b++) {
+        const int64_t *block = values + b * FROZEN_BLOCK;
+        size_t count = n - b * FROZEN_BLOCK;
+        if (count < FROZEN_BLOCK) {
+            // Pad the last block by repeating its last value
+            memcpy(padded, block, count * sizeof(int64_t));
+            for (size_t i = count; i < FROZEN_BLOCK; i++)
+                padded[i] = block[count - 1];
+            block = padded;
+        }
+        if (!encodeBlock(fa, &exceptionCapacity, &rawCapacity, &fa->blocks[b],
+                         block)) {
+            int64FrozenArrayDestroy(fa);
+            return NULL;
+        }
+    }
+
+    // Give back the worst-case reservation
+    uint32_t *packed =
+        realloc(fa->packed, (fa->packedWords + 1) * sizeof(uint32_t));
+    if (packed)
+        fa->packed = packed;
+    return fa;
+}
+
+// Compress the contents of an IntegerDynamicArray.
+Int64FrozenArray *
+int64FrozenArrayFromIntegerDynamicArray(const IntegerDynamicArray *array) {
+    int64_t *wide = malloc((array->size ? array->size : 1) * sizeof(int64_t));
+    if (!wide) {
+        fprintf(stderr, "Memory allocation failed while widening array\n");
+        return NULL;
+    }
+    for (size_t i = 0; i < array->size; i++)
+        wide[i] = array->data[i];
+    Int64FrozenArray *fa = int64FrozenArrayCreate(wide, array->size);
+    free(wide);
+    return fa;
+}
+
+// Read the header words of a packed block and return its packed lows
+static inline const uint32_t *blockHeader(const Int64FrozenArray *fa,
+                                          const FrozenBlock *block,
+                                          uint64_t *minDelta,
+                                          size_t *exceptions) {
+    const uint32_t *words = &fa->packed[block->offset];
+    *minDelta = 0;
+    *exceptions = 0;
+    if (block->mode == FROZEN_DELTA)
+        *minDelta = (uint64_t)(int64_t)(int32_t)*words++;
+    if (block->exceptionCount > 0)
+        *exceptions = *words++;
+    return words;
+}
+
+// Decode block b into out[0..127] (padding included)
+static void decodeBlock(const Int64FrozenArray *fa, size_t b, int64_t *out) {
+    const FrozenBlock *block = &fa->blocks[b];
+    if (block->mode == FROZEN_RAW) {
+        memcpy(out, &fa->raw[(size_t)block->offset * FROZEN_BLOCK],
+               FROZEN_BLOCK * sizeof(int64_t));
+        return;
+    }
+
+    uint64_t minDelta;
+    size_t exceptions;
+    uint32_t lows[FROZEN_BLOCK];
+    unpackBlock(lows, blockHeader(fa, block, &minDelta, &exceptions),
+                block->bits);
+    const uint8_t *positions = &fa->exceptionPositions[exceptions];
+    const uint64_t *highs = &fa->exceptionHighs[exceptions];
+
+    // A residual is low | high << bits with low < 2^bits, so patching an
+    // exception adds its high part to the value (and, for delta blocks, to
+    // every value after it)
+    if (block->mode == FROZEN_FOR) {
+        for (int i = 0; i < FROZEN_BLOCK; i++)
+            out[i] = (int64_t)((uint64_t)block->min + lows[i]);
+        for (uint32_t e = 0; e < block->exceptionCount; e++) {
+            uint64_t high = highs[e] << block->bits;
+            out[positions[e]] = (int64_t)((uint64_t)out[positions[e]] + high);
+        }
+    } else {
+        uint64_t value = (uint64_t)block->min + lows[0];
+        out[0] = (int64_t)value;
+        for (int i = 1; i < FROZEN_BLOCK; i++) {
+            value += minDelta + lows[i];
+            out[i] = (int64_t)value;
+        }
+        for (uint32_t e = 0; e < block->exceptionCount; e++) {
+            uint64_t high = highs[e] << block->bits;
+            for (int i = positions[e]; i < FROZEN_BLOCK; i++)
+                out[i] = (int64_t)((uint64_t)out[i] + high);
+        }
+    }
+}
+
+// Get the value at index i. FOR and raw blocks extract a single value. A
+// delta value is the sum of all steps before it, so delta blocks unpack
+// their 128 residuals and add up the prefix: several times the cost of a FOR
+// lookup, and the price of the better ratio on sorted data.
+int64_t int64FrozenArrayGet(const Int64FrozenArray *fa, size_t i) {
+    if (i >= fa->size) {
+        fprintf(stderr, "Error: index %zu out of range (size %zu)\n", i,
+                fa->size);
+        exit(EXIT_FAILURE);
+    }
+    const FrozenBlock *block = &fa->blocks[i / FROZEN_BLOCK];
+    size_t j = i % FROZEN_BLOCK;
+    if (block->mode == FROZEN_RAW)
+        return fa->raw[(size_t)block->offset * FROZEN_BLOCK + j];
+
+    uint64_t minDelta;
+    size_t exceptions;
+    const uint32_t *packed = blockHeader(fa, block, &minDelta, &exceptions);
+    if (block->mode == FROZEN_DELTA) {
+        uint32_t lows[FROZEN_BLOCK];
+        unpackBlock(lows, packed, block->bits);
+        uint64_t value = (uint64_t)block->min + j * minDelta;
+        for (size_t k = 0; k <= j; k++)
+            value += lows[k];
+        for (uint32_t e = 0; e < block->exceptionCount; e++) {
+            size_t k = exceptions + e;
+            if (fa->exceptionPositions[k] <= j)
+                value += fa->exceptionHighs[k] << block->bits;
+        }
+        return (int64_t)value;
+    }
+
+    uint64_t residual = 0;
+    unsigned bits = block->bits;
+    if (bits > 0) {
+        const uint32_t *lane = packed + j % 4;
+        unsigned bit = (unsigned)(j / 4) * bits;
+        unsigned word = bit / 32, offset = bit % 32;
+        uint64_t low = lane[4 * word] >> offset;
+        if (offset + bits > 32)
+            low |= (uint64_t)lane[4 * (word + 1)] << (32 - offset);
+        residual = low & ((1ULL << bits) - 1);
+    }
+    for (uint32_t e = 0; e < block->exceptionCount; e++) {
+        size_t k = exceptions + e;
+        if (fa->exceptionPositions[k] == j)
+            residual |= fa->exceptionHighs[k] << bits;
+    }
+    return (int64_t)((uint64_t)block->min + residual);
+}
+
+// Decompress every value into out (room for size values).
+void int64FrozenArrayDecompress(const Int64FrozenArray *fa, int64_t *out) {
+    int64_t values[FROZEN_BLOCK];
+    for (size_t b = 0; b < fa->blockCount; b++) {
+        size_t count = fa->size - b * FROZEN_BLOCK;
+        if (count >= FROZEN_BLOCK) {
+            decodeBlock(fa, b, out + b * FROZEN_BLOCK);
+        } else {
+            decodeBlock(fa, b, values);
+            memcpy(out + b * FROZEN_BLOCK, values, count * sizeof(int64_t));
+        }
+    }
+}
+
+// Sum all values, decoding block by block (a decompress-and-scan kernel).
+int64_t int64FrozenArraySum(const Int64FrozenArray *fa) {
+    uint64_t sum = 0;
+    int64_t values[FROZEN_BLOCK];
+    for (size_t b = 0; b < fa->blockCount; b++) {
+        decodeBlock(fa, b, values);
+        size_t count = fa->size - b * FROZEN_BLOCK;
+        if (count > FROZEN_BLOCK)
+            count = FROZEN_BLOCK;
+        for (size_t i = 0; i < count; i++)
+            sum += (uint64_t)values[i];
+    }
+    return (int64_t)sum;
+}
+
+// Index of the first of `count` values equal to `value`, or count
+static size_t findInBlockScalar(const int64_t *values, size_t count,
+                                int64_t value) {
+    for (size_t i = 0; i < count; i++) {
+        if (values[i] == value)
+            return i;
+    }
+    return count;
+}
+
+#ifdef HAVE_X86_KERNELS
+__attribute__((target("avx2"))) static size_t
+findInBlockAvx2(const int64_t *values, size_t count, int64_t value) {
+    __m256i needle = _mm256_set1_epi64x(value);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(values + i));
+        int mask = _mm256_movemask_pd(
+            _mm256_castsi256_pd(_mm256_cmpeq_epi64(v, needle)));
+        if (mask)
+            return i + (size_t)__builtin_ctz((unsigned)mask);
+    }
+    return i + findInBlockScalar(values + i, count - i, value);
+}
+#endif
+
+static size_t (*findInBlock)(const int64_t *, size_t,
+                             int64_t) = findInBlockScalar;
+
+// Select the AVX2 block search before main() runs when the CPU has it
+__attribute__((constructor)) static void selectFindKernel(void) {
+#ifdef HAVE_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        findInBlock = findInBlockAvx2;
+#endif
+}
+
+// Find the index of the first occurrence of `value`. Blocks whose range
+// [min, min + 2^rangeBits) excludes it are skipped through the directory;
+// candidates are decoded and compared with SIMD. Returns true and sets *index
+// if found.
+bool int64FrozenArrayFind(const Int64FrozenArray *fa, int64_t value,
+                          size_t *index) {
+    int64_t values[FROZEN_BLOCK];
+    for (size_t b = 0; b < fa->blockCount; b++) {
+        const FrozenBlock *block = &fa->blocks[b];
+        uint64_t offset = (uint64_t)value - (uint64_t)block->min;
+        if (value < block->min ||
+            (block->rangeBits < 64 && offset >> block->rangeBits != 0))
+            continue;
+        decodeBlock(fa, b, values);
+        size_t count = fa->size - b * FROZEN_BLOCK;
+        if (count > FROZEN_BLOCK)
+            count = FROZEN_BLOCK;
+        size_t j = findInBlock(values, count, value);
+        if (j < count) {
+            *index = b * FROZEN_BLOCK + j;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Get the number of values.
+size_t int64FrozenArraySize(const Int64FrozenArray *fa) { return fa->size; }
+
+// Get the compressed footprint in bytes (directory, packed data, exceptions
+// and raw blocks).
+size_t int64FrozenArrayBytes(const Int64FrozenArray *fa) {
+    return sizeof(*fa) + fa->blockCount * sizeof(FrozenBlock) +
+           fa->packedWords * sizeof(uint32_t) +
+           fa->exceptionCount * (sizeof(uint8_t) + sizeof(uint64_t)) +
+           fa->rawCount * sizeof(int64_t);
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Compress a column, verify it, and report ratio and access speeds
+static void benchmark(const char *label, const int64_t *values, size_t n) {
+    double start = nowSeconds();
+    Int64FrozenArray *fa = int64FrozenArrayCreate(values, n);
+    if (!fa)
+        return;
+    double built = nowSeconds() - start;
+
+    int64_t *decoded = malloc(n * sizeof(int64_t));
+    if (!decoded) {
+        int64FrozenArrayDestroy(fa);
+        return;
+    }
+    start = nowSeconds();
+    int64FrozenArrayDecompress(fa, decoded);
+    double decompress = nowSeconds() - start;
+    bool exact = memcmp(decoded, values, n * sizeof(int64_t)) == 0;
+
+    start = nowSeconds();
+    int64_t sum = int64FrozenArraySum(fa);
+    double scan = nowSeconds() - start;
+    uint64_t expected = 0;
+    for (size_t i = 0; i < n; i++)
+        expected += (uint64_t)values[i];
+    exact &= (uint64_t)sum == expected;
+
+    size_t probes = 1000000;
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    start = nowSeconds();
+    for (size_t p = 0; p < probes; p++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        size_t i = state % n;
+        exact &= int64FrozenArrayGet(fa, i) == values[i];
+    }
+    double access = nowSeconds() - start;
+
+    // Search for the last value: the zone map skips blocks that cannot hold it
+    size_t index;
+    start = nowSeconds();
+    bool found = int64FrozenArrayFind(fa, values[n - 1], &index);
+    double find = nowSeconds() - start;
+    exact &= found && values[index] == values[n - 1];
+
+    double bytes = (double)int64FrozenArrayBytes(fa);
+    printf("%-14s %5.2f bits/value, %5.1fx vs int64 (build %.2f s)\n", label,
+           bytes * 8 / (double)n, (double)(n * sizeof(int64_t)) / bytes,
+           built);
+    printf("%14s decompress %6.0f M/s, sum %6.0f M/s, get %4.0f ns, "
+           "find %.3f ms%s\n",
+           "", (double)n / decompress / 1e6, (double)n / scan / 1e6,
+           access * 1e9 / (double)probes, find * 1e3,
+           exact ? "" : "  MISMATCH");
+    free(decoded);
+    int64FrozenArrayDestroy(fa);
+}
+
+int main(void) {
+    // Small IntegerDynamicArray round trip
+    int small[] = {1000, 1003, 1004, 1010, 1011, 1011, 1020, -5, 1030};
+    IntegerDynamicArray vec = {small, sizeof(small) / sizeof(*small),
+                               sizeof(small) / sizeof(*small)};
+    Int64FrozenArray *fa = int64FrozenArrayFromIntegerDynamicArray(&vec);
+    if (!fa)
+        return EXIT_FAILURE;
+    printf("Frozen %zu values:", int64FrozenArraySize(fa));
+    for (size_t i = 0; i < int64FrozenArraySize(fa); i++)
+        printf(" %lld", (long long)int64FrozenArrayGet(fa, i));
+    size_t index;
+    if (int64FrozenArrayFind(fa, 1011, &index))
+        printf("\nFound 1011 at index %zu\n\n", index);
+    int64FrozenArrayDestroy(fa);
+
+    size_t n = 16000000;
+    int64_t *values = malloc(n * sizeof(int64_t));
+    if (!values)
+        return EXIT_FAILURE;
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+#define NEXT_RANDOM()                                                          \
+    (state ^= state << 13, state ^= state >> 7, state ^= state << 17, state)
+
+    // Sorted ids with small random gaps
+    int64_t id = 1000000000000LL;
+    for (size_t i = 0; i < n; i++) {
+        id += 1 + (int64_t)(NEXT_RANDOM() % 16);
+        values[i] = id;
+    }
+    benchmark("sorted ids", values, n);
+
+    // Nearly sorted: local jitter plus rare large outliers
+    for (size_t i = 0; i < n; i++) {
+        values[i] = (int64_t)(i * 8) + (int64_t)(NEXT_RANDOM() % 64);
+        if (NEXT_RANDOM() % 1000 == 0)
+            values[i] = (int64_t)(NEXT_RANDOM() >> 4);
+    }
+    benchmark("nearly sorted", values, n);
+
+    // Small-range unsorted codes
+    for (size_t i = 0; i < n; i++)
+        values[i] = (int64_t)(NEXT_RANDOM() % 1000);
+    benchmark("codes < 1000", values, n);
+
+    // Random 64-bit values do not compress (raw blocks)
+    for (size_t i = 0; i < n; i++)
+        values[i] = (int64_t)NEXT_RANDOM();
+    benchmark("random", values, n);
+#undef NEXT_RANDOM
+
+    free(values);
+    return EXIT_SUCCESS;
+}
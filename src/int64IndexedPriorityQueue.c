@@ -0,0 +1,321 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Position of a handle that is not in the queue
+#define HANDLE_ABSENT UINT32_MAX
+
+// Max priority queue over dense integer handles [0, handleCapacity).
+// Every handle appears at most once, and its heap position is tracked in a
+// flat array so that its priority can be changed or the handle removed in
+// O(log n) without searching or hashing. Handles and positions are 32-bit to
+// keep the position map at 4 bytes per node for very large graphs.
+typedef struct {
+    int64_t *priorities; // heap-ordered priorities
+    uint32_t *handles;   // handle stored at each heap position
+    uint32_t *positions; // heap position of each handle, or HANDLE_ABSENT
+    size_t size;         // number of elements in the heap
+    size_t capacity;     // maximum number of elements in the heap
+    size_t handleCapacity;
+} Int64IndexedPriorityQueue;
+
+// Index helpers
+static inline size_t getParentIndex(size_t i) { return (i - 1) / 2; }
+static inline size_t getLeftChildIndex(size_t i) { return 2 * i + 1; }
+
+// Place handle/priority at heap position i and update the position map
+static inline void placeNode(Int64IndexedPriorityQueue *pq, size_t i,
+                             uint32_t handle, int64_t priority) {
+    pq->priorities[i] = priority;
+    pq->handles[i] = handle;
+    pq->positions[handle] = (uint32_t)i;
+}
+
+// Resize the heap arrays
+static bool int64IndexedPriorityQueueResize(Int64IndexedPriorityQueue *pq,
+                                            size_t newCapacity) {
+    int64_t *newPriorities =
+        realloc(pq->priorities, newCapacity * sizeof(int64_t));
+    if (!newPriorities) {
+        fprintf(stderr, "Memory (re)allocation failed for capacity %zu\n",
+                newCapacity);
+        return false;
+    }
+    pq->priorities = newPriorities;
+
+    uint32_t *newHandles = realloc(pq->handles, newCapacity * sizeof(uint32_t));
+    if (!newHandles) {
+        fprintf(stderr, "Memory (re)allocation failed for capacity %zu\n",
+                newCapacity);
+        return false;
+    }
+    pq->handles = newHandles;
+    pq->capacity = newCapacity;
+    return true;
+}
+
+// Create a new indexed priority queue accepting handles [0, handleCapacity).
+Int64IndexedPriorityQueue *
+int64IndexedPriorityQueueCreate(size_t handleCapacity) {
+    if (handleCapacity == 0 || handleCapacity >= HANDLE_ABSENT) {
+        fprintf(stderr, "Handle capacity must be in [1, %u) (got %zu)\n",
+                HANDLE_ABSENT, handleCapacity);
+        return NULL;
+    }
+
+    Int64IndexedPriorityQueue *pq = calloc(1, sizeof(*pq));
+    if (!pq) {
+        fprintf(stderr,
+                "Memory allocation failed for Int64IndexedPriorityQueue\n");
+        return NULL;
+    }
+
+    // The heap starts small; only the position map is sized up front
+    size_t initialCapacity = handleCapacity < 16 ? handleCapacity : 16;
+    pq->priorities = malloc(initialCapacity * sizeof(*pq->priorities));
+    pq->handles = malloc(initialCapacity * sizeof(*pq->handles));
+    pq->positions = malloc(handleCapacity * sizeof(*pq->positions));
+    if (!pq->priorities || !pq->handles || !pq->positions) {
+        fprintf(stderr, "Memory allocation failed for data arrays\n");
+        free(pq->priorities);
+        free(pq->handles);
+        free(pq->positions);
+        free(pq);
+        return NULL;
+    }
+    for (size_t h = 0; h < handleCapacity; h++)
+        pq->positions[h] = HANDLE_ABSENT;
+
+    pq->size = 0;
+    pq->capacity = initialCapacity;
+    pq->handleCapacity = handleCapacity;
+    return pq;
+}
+
+// Destroy the indexed priority queue memory
+void int64IndexedPriorityQueueDestroy(Int64IndexedPriorityQueue *pq) {
+    if (!pq)
+        return;
+    free(pq->priorities);
+    free(pq->handles);
+    free(pq->positions);
+    free(pq);
+}
+
+// Restore the max‐heap property moving node i up.
+// Returns the final position of the node.
+static size_t heapifyUp(Int64IndexedPriorityQueue *pq, size_t i) {
+    int64_t priority = pq->priorities[i];
+    uint32_t handle = pq->handles[i];
+
+    while (i > 0) {
+        size_t parent = getParentIndex(i);
+        if (pq->priorities[parent] >= priority)
+            break;
+        placeNode(pq, i, pq->handles[parent], pq->priorities[parent]);
+        i = parent;
+    }
+    placeNode(pq, i, handle, priority);
+    return i;
+}
+
+// Restore the max‐heap property moving node i down
+static void heapifyDown(Int64IndexedPriorityQueue *pq, size_t i) {
+    int64_t priority = pq->priorities[i];
+    uint32_t handle = pq->handles[i];
+
+    while (true) {
+        size_t left = getLeftChildIndex(i);
+        if (left >= pq->size)
+            break;
+
+        size_t largest = left;
+        size_t right = left + 1;
+        if (right < pq->size && pq->priorities[right] > pq->priorities[left])
+            largest = right;
+        if (pq->priorities[largest] <= priority) {
+            // The max-heap property is satisfied
+            break;
+        }
+
+        placeNode(pq, i, pq->handles[largest], pq->priorities[largest]);
+        i = largest;
+    }
+    placeNode(pq, i, handle, priority);
+}
+
+// Check if the handle is currently in the queue.
+bool int64IndexedPriorityQueueContains(const Int64IndexedPriorityQueue *pq,
+                                       size_t handle) {
+    return handle < pq->handleCapacity &&
+           pq->positions[handle] != HANDLE_ABSENT;
+}
+
+// Push a handle with the given priority.
+// Return false if the handle is out of range, already queued, or if memory
+// allocation fails.
+bool int64IndexedPriorityQueuePush(Int64IndexedPriorityQueue *pq,
+                                   size_t handle, int64_t priority) {
+    if (handle >= pq->handleCapacity) {
+        fprintf(stderr, "Handle %zu out of range [0, %zu)\n", handle,
+                pq->handleCapacity);
+        return false;
+    }
+    if (pq->positions[handle] != HANDLE_ABSENT)
+        return false;
+
+    if (pq->size + 1 > pq->capacity) {
+        size_t newCapacity = pq->capacity * 2;
+        if (newCapacity > pq->handleCapacity)
+            newCapacity = pq->handleCapacity;
+        if (!int64IndexedPriorityQueueResize(pq, newCapacity))
+            return false;
+    }
+
+    placeNode(pq, pq->size, (uint32_t)handle, priority);
+    pq->size++;
+    heapifyUp(pq, pq->size - 1);
+    return true;
+}
+
+// Change the priority of a queued handle (increase-key or decrease-key).
+// Return false if the handle is not in the queue.
+bool int64IndexedPriorityQueueUpdate(Int64IndexedPriorityQueue *pq,
+                                     size_t handle, int64_t priority) {
+    if (!int64IndexedPriorityQueueContains(pq, handle))
+        return false;
+
+    size_t i = pq->positions[handle];
+    int64_t old = pq->priorities[i];
+    pq->priorities[i] = priority;
+    if (priority > old)
+        heapifyUp(pq, i);
+    else if (priority < old)
+        heapifyDown(pq, i);
+    return true;
+}
+
+// Remove a queued handle regardless of its position.
+// Return false if the handle is not in the queue.
+bool int64IndexedPriorityQueueRemove(Int64IndexedPriorityQueue *pq,
+                                     size_t handle) {
+    if (!int64IndexedPriorityQueueContains(pq, handle))
+        return false;
+
+    size_t i = pq->positions[handle];
+    pq->positions[handle] = HANDLE_ABSENT;
+    pq->size--;
+    if (i == pq->size)
+        return true;
+
+    // Fill the hole with the last node, which may have to move either way
+    placeNode(pq, i, pq->handles[pq->size], pq->priorities[pq->size]);
+    if (heapifyUp(pq, i) == i)
+        heapifyDown(pq, i);
+    return true;
+}
+
+// Get the priority of a queued handle.
+// Return false if the handle is not in the queue.
+bool int64IndexedPriorityQueueGetPriority(const Int64IndexedPriorityQueue *pq,
+                                          size_t handle, int64_t *priority) {
+    if (!int64IndexedPriorityQueueContains(pq, handle))
+        return false;
+    *priority = pq->priorities[pq->positions[handle]];
+    return true;
+}
+
+// Pop the handle with the maximum priority; its priority is stored in
+// *priority if non-NULL.
+size_t int64IndexedPriorityQueuePop(Int64IndexedPriorityQueue *pq,
+                                    int64_t *priority) {
+    if (pq->size == 0) {
+        fprintf(stderr, "Error: pop() called on empty priority queue\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t handle = pq->handles[0];
+    if (priority)
+        *priority = pq->priorities[0];
+    int64IndexedPriorityQueueRemove(pq, handle);
+    return handle;
+}
+
+// Peek at the handle with the maximum priority without removing it.
+size_t int64IndexedPriorityQueuePeek(const Int64IndexedPriorityQueue *pq) {
+    if (pq->size == 0) {
+        fprintf(stderr, "Error: peek() called on empty priority queue\n");
+        exit(EXIT_FAILURE);
+    }
+    return pq->handles[0];
+}
+
+// Check if the queue is empty.
+bool int64IndexedPriorityQueueIsEmpty(const Int64IndexedPriorityQueue *pq) {
+    return pq->size == 0;
+}
+
+// Get the size of the queue.
+size_t int64IndexedPriorityQueueSize(const Int64IndexedPriorityQueue *pq) {
+    return pq->size;
+}
+
+// Example usage: Dijkstra on a small graph.
+// The queue is a max-heap, so distances are pushed negated.
+int main(void) {
+    enum { NODES = 6 };
+    // Adjacency matrix, 0 means no edge
+    const int64_t weights[NODES][NODES] = {
+        {0, 7, 9, 0, 0, 14}, {7, 0, 10, 15, 0, 0}, {9, 10, 0, 11, 0, 2},
+        {0, 15, 11, 0, 6, 0}, {0, 0, 0, 6, 0, 9},  {14, 0, 2, 0, 9, 0},
+    };
+    int64_t distance[NODES];
+    bool done[NODES] = {false};
+
+    Int64IndexedPriorityQueue *pq = int64IndexedPriorityQueueCreate(NODES);
+    if (!pq) {
+        fprintf(stderr, "Failed to create indexed priority queue\n");
+        return EXIT_FAILURE;
+    }
+
+    for (size_t v = 0; v < NODES; v++)
+        distance[v] = INT64_MAX;
+    distance[0] = 0;
+    int64IndexedPriorityQueuePush(pq, 0, 0);
+
+    while (!int64IndexedPriorityQueueIsEmpty(pq)) {
+        size_t u = int64IndexedPriorityQueuePop(pq, NULL);
+        done[u] = true;
+        for (size_t v = 0; v < NODES; v++) {
+            if (!weights[u][v] || done[v])
+                continue;
+            int64_t candidate = distance[u] + weights[u][v];
+            if (candidate >= distance[v])
+                continue;
+            distance[v] = candidate;
+            // Decrease-key instead of pushing a duplicate entry
+            if (!int64IndexedPriorityQueueUpdate(pq, v, -candidate))
+                int64IndexedPriorityQueuePush(pq, v, -candidate);
+        }
+    }
+
+    printf("Shortest distances from node 0:\n");
+    for (size_t v = 0; v < NODES; v++)
+        printf("  node %zu: %ld\n", v, distance[v]);
+
+    // Arbitrary removal keeps the heap valid
+    for (size_t v = 0; v < NODES; v++)
+        int64IndexedPriorityQueuePush(pq, v, (int64_t)(v * 7 % NODES));
+    int64IndexedPriorityQueueRemove(pq, 3);
+    printf("\nAfter removing handle 3, pop order (handle:priority):\n");
+    while (!int64IndexedPriorityQueueIsEmpty(pq)) {
+        int64_t priority;
+        size_t handle = int64IndexedPriorityQueuePop(pq, &priority);
+        printf("%zu:%ld ", handle, priority);
+    }
+    printf("\n");
+
+    int64IndexedPriorityQueueDestroy(pq);
+    return EXIT_SUCCESS;
+}
@@ -1,6 +1,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 typedef struct {
     int64_t *data;   // Array to store the heap elements
@@ -124,6 +125,84 @@ bool int64MaxHeapInsert(Int64MaxHeap *h, int64_t value) {
     return true;
 }
 
+// Rebuild the max heap property over the whole array in O(n) time
+// using Floyd's bottom-up heapify
+static void heapifyAll(Int64MaxHeap *h) {
+    if (h->size < 2) {
+        // Empty and single-element arrays are already heaps
+        return;
+    }
+
+    // Leaves are trivially heaps, so sift down every internal node
+    // starting from the last one and walking back to the root
+    for (size_t i = heapParent(h->size - 1) + 1; i-- > 0;)
+        heapifyDown(h, i);
+}
+
+// Build a heap from an existing array in O(n) time.
+// If takeOwnership is true, `values` must be heap-allocated and becomes the
+// heap's storage (the caller must not free it), otherwise it is copied.
+// Return NULL if memory allocation fails.
+Int64MaxHeap *int64MaxHeapFromArray(int64_t *values, size_t count,
+                                    bool takeOwnership) {
+    Int64MaxHeap *h;
+    if (takeOwnership && values && count > 0) {
+        h = calloc(1, sizeof(Int64MaxHeap));
+        if (!h) {
+            fprintf(stderr, "Failed to create Int64MaxHeap\n");
+            return NULL;
+        }
+        h->data = values;
+        h->capacity = count;
+    } else {
+        h = int64MaxHeapCreate(count > 0 ? count : 1);
+        if (!h)
+            return NULL;
+        if (count > 0)
+            memcpy(h->data, values, count * sizeof(int64_t));
+        if (takeOwnership)
+            free(values);
+    }
+
+    h->size = count;
+    heapifyAll(h);
+    return h;
+}
+
+// Insert a batch of values into the heap.
+// A small batch is inserted one value at a time, while a large one is
+// appended and the whole heap is re-heapified, which costs O(n + k) instead
+// of O(k log n). Return true if successful, false if memory allocation fails.
+bool int64MaxHeapInsertMany(Int64MaxHeap *h, const int64_t *values,
+                            size_t count) {
+    size_t total = h->size + count;
+    if (total > h->capacity) {
+        size_t newCapacity = h->capacity;
+        while (newCapacity < total)
+            newCapacity *= 2;
+        if (!int64MaxHeapResize(h, newCapacity))
+            return false;
+    }
+
+    // Estimate the sift-up cost as count * log2(total)
+    size_t depth = 0;
+    for (size_t n = total; n > 1; n >>= 1)
+        depth++;
+
+    if (count * depth <= total) {
+        for (size_t i = 0; i < count; i++) {
+            h->data[h->size] = values[i];
+            h->size++;
+            heapifyUp(h, h->size - 1);
+        }
+    } else {
+        memcpy(h->data + h->size, values, count * sizeof(int64_t));
+        h->size = total;
+        heapifyAll(h);
+    }
+    return true;
+}
+
 // Peek the maximum value in the heap without removing it.
 int64_t int64MaxHeapPeek(const Int64MaxHeap *h) {
     if (h->size == 0) {
@@ -165,6 +244,22 @@ int main(void) {
         printf("%lld ", (long long)int64MaxHeapExtract(heap));
     printf("\n");
 
+    int64MaxHeapDestroy(heap);
+
+    // Bulk construction from a copied array, then a large batch insert
+    int64_t values[] = {9, -4, 27, 0, 15, -8, 33, 6, 21, -1};
+    heap = int64MaxHeapFromArray(values, sizeof(values) / sizeof(*values),
+                                 false);
+    if (!heap)
+        return 1;
+    int64_t batch[] = {50, -50, 12, 12, 3, 44, -7, 18, 5, 30, 2};
+    int64MaxHeapInsertMany(heap, batch, sizeof(batch) / sizeof(*batch));
+
+    printf("Bulk-loaded heap outputs in descending order:\n");
+    while (!int64MaxHeapIsEmpty(heap))
+        printf("%lld ", (long long)int64MaxHeapExtract(heap));
+    printf("\n");
+
     int64MaxHeapDestroy(heap);
     return 0;
 }
@@ -0,0 +1,402 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Min-max heap: a double-ended priority queue in a single array.
+// Nodes on even levels (the root is level 0) are smaller than all of their
+// descendants, nodes on odd levels are larger than all of their descendants.
+// So the minimum is the root and the maximum is one of its two children.
+typedef struct {
+    int64_t *data;   // Array to store the heap elements
+    size_t size;     // Number of elements in the heap
+    size_t capacity; // Maximum number of elements the heap can hold
+} Int64MinMaxHeap;
+
+// Helper function to compute parent/child indices
+static inline size_t heapParent(size_t index) { return (index - 1) / 2; }
+static inline size_t heapLeftChild(size_t index) { return 2 * index + 1; }
+
+// Nodes on even levels follow the min ordering
+static inline bool isMinLevel(size_t index) {
+    unsigned level = 63 - (unsigned)__builtin_clzll((uint64_t)index + 1);
+    return level % 2 == 0;
+}
+
+// Helper function to swap two elements in the heap
+static inline void int64Swap(int64_t *a, int64_t *b) {
+    int64_t temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+// Resize underlying array to new capacity, doubling strategy
+static bool int64MinMaxHeapResize(Int64MinMaxHeap *h, size_t newCapacity) {
+    int64_t *tmp = realloc(h->data, newCapacity * sizeof(int64_t));
+    if (!tmp) {
+        fprintf(stderr, "Failed to resize heap array\n");
+        return false;
+    }
+    h->data = tmp;
+    h->capacity = newCapacity;
+    return true;
+}
+
+// Create a new Int64MinMaxHeap with the specified initial capacity
+Int64MinMaxHeap *int64MinMaxHeapCreate(size_t capacity) {
+    if (capacity == 0) {
+        fprintf(stderr, "Capacity must be greater than 0\n");
+        return NULL;
+    }
+    Int64MinMaxHeap *h = calloc(1, sizeof(Int64MinMaxHeap));
+    if (!h || !(h->data = calloc(capacity, sizeof(int64_t)))) {
+        fprintf(stderr, "Failed to create Int64MinMaxHeap\n");
+        free(h);
+        return NULL;
+    }
+    h->capacity = capacity;
+    return h;
+}
+
+// Free the Int64MinMaxHeap memory
+void int64MinMaxHeapDestroy(Int64MinMaxHeap *h) {
+    if (h) {
+        free(h->data);
+        free(h);
+    }
+}
+
+// Move node i up through its grandparents. `isMin` selects the ordering of
+// the levels the node travels on.
+static void bubbleUpGrandparents(Int64MinMaxHeap *h, size_t i, bool isMin) {
+    // A grandparent exists for every index > 2
+    while (i > 2) {
+        size_t grandparent = heapParent(heapParent(i));
+        bool outOfOrder = isMin ? h->data[i] < h->data[grandparent]
+                                : h->data[i] > h->data[grandparent];
+        if (!outOfOrder)
+            break;
+        int64Swap(&h->data[i], &h->data[grandparent]);
+        i = grandparent;
+    }
+}
+
+// Restore the min-max heap property upward from index i
+static void heapifyUp(Int64MinMaxHeap *h, size_t i) {
+    if (i == 0)
+        return;
+
+    size_t parent = heapParent(i);
+    if (isMinLevel(i)) {
+        if (h->data[i] > h->data[parent]) {
+            // Larger than its max-level parent: continue on max levels
+            int64Swap(&h->data[i], &h->data[parent]);
+            bubbleUpGrandparents(h, parent, false);
+        } else {
+            bubbleUpGrandparents(h, i, true);
+        }
+    } else {
+        if (h->data[i] < h->data[parent]) {
+            // Smaller than its min-level parent: continue on min levels
+            int64Swap(&h->data[i], &h->data[parent]);
+            bubbleUpGrandparents(h, parent, true);
+        } else {
+            bubbleUpGrandparents(h, i, false);
+        }
+    }
+}
+
+// Restore the min-max heap property downward from index i.
+// The node is compared against its children and grandchildren (up to six
+// candidates) and trickles down two levels at a time.
+static void heapifyDown(Int64MinMaxHeap *h, size_t i) {
+    bool isMin = isMinLevel(i);
+
+    while (true) {
+        size_t firstChild = heapLeftChild(i);
+        if (firstChild >= h->size)
+            break;
+
+        // Find the most extreme descendant among children and grandchildren
+        size_t best = firstChild;
+        size_t candidates[6] = {firstChild,
+                                firstChild + 1,
+                                heapLeftChild(firstChild),
+                                heapLeftChild(firstChild) + 1,
+                                heapLeftChild(firstChild + 1),
+                                heapLeftChild(firstChild + 1) + 1};
+        for (size_t k = 1; k < 6; k++) {
+            size_t c = candidates[k];
+            if (c >= h->size)
+                break;
+            if (isMin ? h->data[c] < h->data[best]
+                      : h->data[c] > h->data[best])
+                best = c;
+        }
+
+        bool better = isMin ? h->data[best] < h->data[i]
+                            : h->data[best] > h->data[i];
+        if (!better) {
+            // The heap property is satisfied
+            break;
+        }
+        int64Swap(&h->data[i], &h->data[best]);
+
+        if (best <= firstChild + 1) {
+            // A direct child ends the trickle-down
+            break;
+        }
+
+        // The swapped-in value may violate the order with its new parent
+        size_t parent = heapParent(best);
+        if (isMin ? h->data[best] > h->data[parent]
+                  : h->data[best] < h->data[parent])
+            int64Swap(&h->data[best], &h->data[parent]);
+        i = best;
+    }
+}
+
+// Insert a new value into the heap.
+// Return true if successful, false if memory allocation fails.
+bool int64MinMaxHeapInsert(Int64MinMaxHeap *h, int64_t value) {
+    if (h->size + 1 > h->capacity) {
+        // Capacity is full, need to resize
+        if (!int64MinMaxHeapResize(h, h->capacity * 2)) {
+            return false;
+        }
+    }
+
+    h->data[h->size] = value;
+    h->size++;
+    heapifyUp(h, h->size - 1);
+    return true;
+}
+
+// Index of the maximum value (the larger child of the root, if any)
+static size_t maxIndex(const Int64MinMaxHeap *h) {
+    if (h->size == 1)
+        return 0;
+    if (h->size == 2 || h->data[1] >= h->data[2])
+        return 1;
+    return 2;
+}
+
+// Peek the minimum value in the heap without removing it.
+int64_t int64MinMaxHeapPeekMin(const Int64MinMaxHeap *h) {
+    if (h->size == 0) {
+        fprintf(stderr, "Heap is empty\n");
+        exit(EXIT_FAILURE);
+    }
+    return h->data[0];
+}
+
+// Peek the maximum value in the heap without removing it.
+int64_t int64MinMaxHeapPeekMax(const Int64MinMaxHeap *h) {
+    if (h->size == 0) {
+        fprintf(stderr, "Heap is empty\n");
+        exit(EXIT_FAILURE);
+    }
+    return h->data[maxIndex(h)];
+}
+
+// Remove the value at index i, replacing it with the last element
+static int64_t extractAt(Int64MinMaxHeap *h, size_t i) {
+    int64_t value = h->data[i];
+    h->size--;
+    if (i < h->size) {
+        h->data[i] = h->data[h->size];
+        heapifyDown(h, i);
+    }
+    return value;
+}
+
+// Remove and return the minimum value from the heap.
+int64_t int64MinMaxHeapExtractMin(Int64MinMaxHeap *h) {
+    if (h->size == 0) {
+        fprintf(stderr, "Heap is empty\n");
+        exit(EXIT_FAILURE);
+    }
+    return extractAt(h, 0);
+}
+
+// Remove and return the maximum value from the heap.
+int64_t int64MinMaxHeapExtractMax(Int64MinMaxHeap *h) {
+    if (h->size == 0) {
+        fprintf(stderr, "Heap is empty\n");
+        exit(EXIT_FAILURE);
+    }
+    return extractAt(h, maxIndex(h));
+}
+
+bool int64MinMaxHeapIsEmpty(const Int64MinMaxHeap *h) { return h->size == 0; }
+
+size_t int64MinMaxHeapSize(const Int64MinMaxHeap *h) { return h->size; }
+
+// ---------------------------------------------------------------------------
+// Benchmark: bounded best-N window
+// ---------------------------------------------------------------------------
+
+// Minimal max heap used to model the two-heap workaround
+typedef struct {
+    int64_t *data;
+    size_t size;
+} PlainMaxHeap;
+
+static void plainPush(PlainMaxHeap *h, int64_t value) {
+    size_t i = h->size++;
+    while (i > 0 && h->data[heapParent(i)] < value) {
+        h->data[i] = h->data[heapParent(i)];
+        i = heapParent(i);
+    }
+    h->data[i] = value;
+}
+
+static int64_t plainPop(PlainMaxHeap *h) {
+    int64_t root = h->data[0];
+    int64_t value = h->data[--h->size];
+    size_t i = 0;
+    while (true) {
+        size_t c = heapLeftChild(i);
+        if (c >= h->size)
+            break;
+        if (c + 1 < h->size && h->data[c + 1] > h->data[c])
+            c++;
+        if (h->data[c] <= value)
+            break;
+        h->data[i] = h->data[c];
+        i = c;
+    }
+    if (h->size > 0)
+        h->data[i] = value;
+    return root;
+}
+
+// Two-heap window: a max heap and a max heap of negated values, each paired
+// with a heap of lazily deleted values that is drained when tops match.
+typedef struct {
+    PlainMaxHeap max, maxDeleted, min, minDeleted;
+    size_t size;
+} TwoHeapWindow;
+
+static void cleanTop(PlainMaxHeap *h, PlainMaxHeap *deleted) {
+    while (deleted->size > 0 && h->data[0] == deleted->data[0]) {
+        plainPop(h);
+        plainPop(deleted);
+    }
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static inline int64_t nextRandom(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return (int64_t)(*state >> 1);
+}
+
+// Keep the best `window` values: insert, evict the min on overflow, and
+// dispatch the max every 4th step. Stores a checksum of dispatched values
+// (summed modulo 2^64); returns false if the heap could not be created.
+static bool benchmarkMinMaxHeap(size_t steps, size_t window,
+                                uint64_t *checksum) {
+    Int64MinMaxHeap *h = int64MinMaxHeapCreate(window + 1);
+    if (!h)
+        return false;
+    uint64_t state = 88172645463325252ULL;
+    *checksum = 0;
+    for (size_t i = 0; i < steps; i++) {
+        int64MinMaxHeapInsert(h, nextRandom(&state));
+        if (int64MinMaxHeapSize(h) > window)
+            int64MinMaxHeapExtractMin(h);
+        if (i % 4 == 3)
+            *checksum += (uint64_t)int64MinMaxHeapExtractMax(h);
+    }
+    int64MinMaxHeapDestroy(h);
+    return true;
+}
+
+static bool benchmarkTwoHeaps(size_t steps, size_t window,
+                              uint64_t *checksum) {
+    TwoHeapWindow w = {0};
+    PlainMaxHeap *heaps[] = {&w.max, &w.maxDeleted, &w.min, &w.minDeleted};
+    bool allocated = true;
+    for (size_t k = 0; k < 4; k++) {
+        heaps[k]->data = malloc((steps + 1) * sizeof(int64_t));
+        allocated &= heaps[k]->data != NULL;
+    }
+    if (!allocated) {
+        fprintf(stderr, "Memory allocation failed for the two heaps\n");
+        for (size_t k = 0; k < 4; k++)
+            free(heaps[k]->data);
+        return false;
+    }
+
+    uint64_t state = 88172645463325252ULL;
+    *checksum = 0;
+    for (size_t i = 0; i < steps; i++) {
+        int64_t value = nextRandom(&state);
+        plainPush(&w.max, value);
+        plainPush(&w.min, -value);
+        w.size++;
+        if (w.size > window) {
+            cleanTop(&w.min, &w.minDeleted);
+            plainPush(&w.maxDeleted, -plainPop(&w.min));
+            w.size--;
+        }
+        if (i % 4 == 3) {
+            cleanTop(&w.max, &w.maxDeleted);
+            int64_t top = plainPop(&w.max);
+            plainPush(&w.minDeleted, -top);
+            *checksum += (uint64_t)top;
+            w.size--;
+        }
+    }
+    for (size_t k = 0; k < 4; k++)
+        free(heaps[k]->data);
+    return true;
+}
+
+// Example usage
+int main(void) {
+    Int64MinMaxHeap *heap = int64MinMaxHeapCreate(4);
+    if (!heap)
+        return 1;
+
+    for (int i = 1; i <= 10; i++)
+        int64MinMaxHeapInsert(heap, i * (i % 2 ? 3 : -2));
+    printf("Min: %lld, Max: %lld\n", (long long)int64MinMaxHeapPeekMin(heap),
+           (long long)int64MinMaxHeapPeekMax(heap));
+
+    // Alternate between both ends until the heap is drained
+    printf("Alternating max/min extraction:\n");
+    bool fromMax = true;
+    while (!int64MinMaxHeapIsEmpty(heap)) {
+        if (fromMax)
+            printf("max %lld ", (long long)int64MinMaxHeapExtractMax(heap));
+        else
+            printf("min %lld ", (long long)int64MinMaxHeapExtractMin(heap));
+        fromMax = !fromMax;
+    }
+    printf("\n");
+    int64MinMaxHeapDestroy(heap);
+
+    size_t steps = 5000000, window = 100000;
+    printf("\nBest-%zu window over %zu values:\n", window, steps);
+    uint64_t a, b;
+    double start = nowSeconds();
+    if (!benchmarkMinMaxHeap(steps, window, &a))
+        return 1;
+    double middle = nowSeconds();
+    if (!benchmarkTwoHeaps(steps, window, &b))
+        return 1;
+    double end = nowSeconds();
+    printf("min-max heap: %.3f s\n", middle - start);
+    printf("two heaps   : %.3f s\n", end - middle);
+    printf("results %s\n", a == b ? "match" : "DIFFER");
+    return 0;
+}
@@ -0,0 +1,391 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Sentinel cached as the top of an empty shard
+#define SHARD_EMPTY_TOP INT64_MIN
+
+// One shard: a binary max-heap (same layout as Int64PriorityQueue) guarded by
+// a try-lock, padded to its own cache line so shards do not false-share.
+typedef struct {
+    pthread_mutex_t lock;
+    int64_t *data;             // heap array
+    size_t size;               // number of elements in the heap
+    size_t capacity;           // maximum number of elements in the heap
+    _Atomic int64_t cachedTop; // top value readable without the lock
+    char padding[64];
+} MultiQueueShard;
+
+// Relaxed concurrent max priority queue (MultiQueue).
+// push inserts into a random shard; pop looks at the cached tops of two
+// random shards and pops from the better one. Pops are not exact, but the
+// rank of a popped element is small in expectation (O(number of shards)),
+// and threads rarely contend on the same lock.
+typedef struct {
+    MultiQueueShard *shards;
+    size_t shardCount;
+    atomic_size_t size;
+} Int64MultiQueue;
+
+// Per-thread random state (xorshift64), seeded by the caller
+typedef struct {
+    uint64_t state;
+} MultiQueueRandom;
+
+static inline uint64_t nextRandom(MultiQueueRandom *r) {
+    r->state ^= r->state << 13;
+    r->state ^= r->state >> 7;
+    r->state ^= r->state << 17;
+    return r->state;
+}
+
+// Shard heap helpers (max-heap, moving a hole instead of swapping)
+static void shardHeapifyUp(MultiQueueShard *s, size_t i) {
+    int64_t value = s->data[i];
+    while (i > 0 && s->data[(i - 1) / 2] < value) {
+        s->data[i] = s->data[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    s->data[i] = value;
+}
+
+static void shardHeapifyDown(MultiQueueShard *s, size_t i) {
+    int64_t value = s->data[i];
+    while (true) {
+        size_t c = 2 * i + 1;
+        if (c >= s->size)
+            break;
+        if (c + 1 < s->size && s->data[c + 1] > s->data[c])
+            c++;
+        if (s->data[c] <= value)
+            break;
+        s->data[i] = s->data[c];
+        i = c;
+    }
+    s->data[i] = value;
+}
+
+static inline void shardUpdateTop(MultiQueueShard *s) {
+    atomic_store_explicit(&s->cachedTop,
+                          s->size > 0 ? s->data[0] : SHARD_EMPTY_TOP,
+                          memory_order_relaxed);
+}
+
+// Create a MultiQueue with `shardsPerThread * threads` shards.
+// The usual choice is 2 to 4 shards per thread.
+Int64MultiQueue *int64MultiQueueCreate(size_t threads, size_t shardsPerThread,
+                                       size_t initialShardCapacity) {
+    if (threads == 0 || shardsPerThread == 0 || initialShardCapacity == 0) {
+        fprintf(stderr,
+                "Threads, shards per thread and capacity must be > 0\n");
+        return NULL;
+    }
+
+    Int64MultiQueue *mq = calloc(1, sizeof(*mq));
+    if (!mq) {
+        fprintf(stderr, "Memory allocation failed for Int64MultiQueue\n");
+        return NULL;
+    }
+    // At least two shards, so that pop always has a choice
+    mq->shardCount = threads * shardsPerThread;
+    if (mq->shardCount < 2)
+        mq->shardCount = 2;
+    mq->shards = calloc(mq->shardCount, sizeof(MultiQueueShard));
+    if (!mq->shards) {
+        fprintf(stderr, "Memory allocation failed for shard array\n");
+        free(mq);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < mq->shardCount; i++) {
+        MultiQueueShard *s = &mq->shards[i];
+        s->data = malloc(initialShardCapacity * sizeof(int64_t));
+        if (!s->data) {
+            fprintf(stderr, "Memory allocation failed for shard heap\n");
+            for (size_t j = 0; j < i; j++) {
+                pthread_mutex_destroy(&mq->shards[j].lock);
+                free(mq->shards[j].data);
+            }
+            free(mq->shards);
+            free(mq);
+            return NULL;
+        }
+        pthread_mutex_init(&s->lock, NULL);
+        s->capacity = initialShardCapacity;
+        atomic_init(&s->cachedTop, SHARD_EMPTY_TOP);
+    }
+    atomic_init(&mq->size, 0);
+    return mq;
+}
+
+// Destroy the MultiQueue memory
+void int64MultiQueueDestroy(Int64MultiQueue *mq) {
+    if (!mq)
+        return;
+    for (size_t i = 0; i < mq->shardCount; i++) {
+        pthread_mutex_destroy(&mq->shards[i].lock);
+        free(mq->shards[i].data);
+    }
+    free(mq->shards);
+    free(mq);
+}
+
+// Push a value into a random shard, retrying on another shard when the
+// chosen one is locked.
+bool int64MultiQueuePush(Int64MultiQueue *mq, MultiQueueRandom *random,
+                         int64_t value) {
+    MultiQueueShard *s;
+    do {
+        s = &mq->shards[nextRandom(random) % mq->shardCount];
+    } while (pthread_mutex_trylock(&s->lock) != 0);
+
+    if (s->size == s->capacity) {
+        size_t newCapacity = s->capacity * 2;
+        int64_t *newData = realloc(s->data, newCapacity * sizeof(int64_t));
+        if (!newData) {
+            pthread_mutex_unlock(&s->lock);
+            fprintf(stderr, "Memory (re)allocation failed for capacity %zu\n",
+                    newCapacity);
+            return false;
+        }
+        s->data = newData;
+        s->capacity = newCapacity;
+    }
+
+    s->data[s->size] = value;
+    shardHeapifyUp(s, s->size);
+    s->size++;
+    shardUpdateTop(s);
+    pthread_mutex_unlock(&s->lock);
+    atomic_fetch_add_explicit(&mq->size, 1, memory_order_relaxed);
+    return true;
+}
+
+// Pop an approximately maximal value: the larger top of two random shards.
+// Return false if the queue looked empty (every shard was seen empty).
+bool int64MultiQueuePop(Int64MultiQueue *mq, MultiQueueRandom *random,
+                        int64_t *value) {
+    while (atomic_load_explicit(&mq->size, memory_order_relaxed) > 0) {
+        size_t a = nextRandom(random) % mq->shardCount;
+        size_t b = nextRandom(random) % mq->shardCount;
+        int64_t topA = atomic_load_explicit(&mq->shards[a].cachedTop,
+                                            memory_order_relaxed);
+        int64_t topB = atomic_load_explicit(&mq->shards[b].cachedTop,
+                                            memory_order_relaxed);
+        MultiQueueShard *s = &mq->shards[topA >= topB ? a : b];
+        if (pthread_mutex_trylock(&s->lock) != 0)
+            continue;
+
+        // The cached top may be stale; only the locked heap is authoritative
+        if (s->size == 0) {
+            pthread_mutex_unlock(&s->lock);
+            continue;
+        }
+        *value = s->data[0];
+        s->size--;
+        if (s->size > 0) {
+            s->data[0] = s->data[s->size];
+            shardHeapifyDown(s, 0);
+        }
+        shardUpdateTop(s);
+        pthread_mutex_unlock(&s->lock);
+        atomic_fetch_sub_explicit(&mq->size, 1, memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+// Approximate number of elements (exact when no operation is in flight).
+size_t int64MultiQueueSize(Int64MultiQueue *mq) {
+    return atomic_load_explicit(&mq->size, memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: throughput scaling and rank error
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    Int64MultiQueue *mq;
+    size_t threadId;
+    size_t operations;
+} MultiQueueWorker;
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Alternate push and pop, keeping the queue size roughly constant
+static void *multiQueueWorkerRun(void *arg) {
+    MultiQueueWorker *w = arg;
+    MultiQueueRandom random = {0x9e3779b97f4a7c15ULL * (w->threadId + 1)};
+    int64_t value;
+    for (size_t i = 0; i < w->operations; i++) {
+        if (i % 2 == 0)
+            int64MultiQueuePush(w->mq, &random, (int64_t)nextRandom(&random));
+        else
+            int64MultiQueuePop(w->mq, &random, &value);
+    }
+    return NULL;
+}
+
+static double measureThroughput(size_t threads, size_t operations) {
+    Int64MultiQueue *mq = int64MultiQueueCreate(threads, 4, 1024);
+    MultiQueueRandom random = {12345};
+    for (size_t i = 0; i < 1000000; i++)
+        int64MultiQueuePush(mq, &random, (int64_t)nextRandom(&random));
+
+    pthread_t tids[64];
+    MultiQueueWorker workers[64];
+    double start = nowSeconds();
+    for (size_t t = 0; t < threads; t++) {
+        workers[t] = (MultiQueueWorker){mq, t, operations / threads};
+        pthread_create(&tids[t], NULL, multiQueueWorkerRun, &workers[t]);
+    }
+    for (size_t t = 0; t < threads; t++)
+        pthread_join(tids[t], NULL);
+    double elapsed = nowSeconds() - start;
+    int64MultiQueueDestroy(mq);
+    return (double)operations / elapsed / 1e6;
+}
+
+typedef struct {
+    Int64MultiQueue *mq;
+    size_t threadId;
+    atomic_size_t *nextTicket; // shared pop counter
+    int64_t *popped;           // popped[ticket] = value of that pop
+} RankWorker;
+
+// Pop until the queue is empty, numbering pops with a shared ticket. The
+// ticket is taken right after the pop returns, so ticket order is the pop
+// order up to pops that complete at the same moment on different threads.
+static void *rankWorkerRun(void *arg) {
+    RankWorker *w = arg;
+    MultiQueueRandom random = {0x9e3779b97f4a7c15ULL * (w->threadId + 1)};
+    int64_t value;
+    while (int64MultiQueuePop(w->mq, &random, &value)) {
+        size_t ticket = atomic_fetch_add(w->nextTicket, 1);
+        w->popped[ticket] = value;
+    }
+    return NULL;
+}
+
+// Rank error of concurrent pops by `threads` threads: values 0..n-1 are
+// pushed, the threads drain the queue, and afterwards each popped value's
+// rank among the values still present at its ticket is counted with a
+// Fenwick tree.
+static bool measureRankError(size_t threads, size_t n) {
+    Int64MultiQueue *mq = int64MultiQueueCreate(threads, 4, 1024);
+    if (!mq)
+        return false;
+    MultiQueueRandom random = {987654321};
+    for (size_t i = 0; i < n; i++)
+        int64MultiQueuePush(mq, &random, (int64_t)i);
+
+    int64_t *popped = malloc(n * sizeof(int64_t));
+    uint32_t *tree = calloc(n + 1, sizeof(uint32_t));
+    if (!popped || !tree) {
+        fprintf(stderr, "Memory allocation failed for rank measurement\n");
+        free(popped);
+        free(tree);
+        int64MultiQueueDestroy(mq);
+        return false;
+    }
+
+    atomic_size_t nextTicket;
+    atomic_init(&nextTicket, 0);
+    pthread_t tids[64];
+    RankWorker workers[64];
+    for (size_t t = 0; t < threads; t++) {
+        workers[t] = (RankWorker){mq, t, &nextTicket, popped};
+        pthread_create(&tids[t], NULL, rankWorkerRun, &workers[t]);
+    }
+    for (size_t t = 0; t < threads; t++)
+        pthread_join(tids[t], NULL);
+
+    // Fenwick tree over present values
+    for (size_t i = 1; i <= n; i++) {
+        tree[i]++;
+        size_t parent = i + (i & -i);
+        if (parent <= n)
+            tree[parent] += tree[i];
+    }
+
+    size_t buckets[6] = {0}; // rank 0, 1-3, 4-15, 16-63, 64-255, 256+
+    double totalRank = 0;
+    size_t maxRank = 0;
+    for (size_t k = 0; k < n; k++) {
+        // rank = number of present values greater than the popped one
+        size_t value = (size_t)popped[k];
+        size_t below = 0;
+        for (size_t i = value + 1; i > 0; i -= i & -i)
+            below += tree[i];
+        size_t rank = (n - k) - below;
+        for (size_t i = value + 1; i <= n; i += i & -i)
+            tree[i]--;
+
+        totalRank += (double)rank;
+        if (rank > maxRank)
+            maxRank = rank;
+        size_t bucket = 0;
+        for (size_t limit = 1; bucket < 5 && rank >= limit; limit *= 4)
+            bucket++;
+        buckets[bucket]++;
+    }
+
+    printf("%2zu threads, %3zu shards: mean rank %6.2f, max %5zu | 0:%5.1f%% "
+           "1-3:%5.1f%% 4-15:%5.1f%% 16-63:%5.1f%% 64-255:%4.1f%% "
+           "256+:%4.1f%%\n",
+           threads, mq->shardCount, totalRank / (double)n, maxRank,
+           100.0 * (double)buckets[0] / (double)n,
+           100.0 * (double)buckets[1] / (double)n,
+           100.0 * (double)buckets[2] / (double)n,
+           100.0 * (double)buckets[3] / (double)n,
+           100.0 * (double)buckets[4] / (double)n,
+           100.0 * (double)buckets[5] / (double)n);
+    free(popped);
+    free(tree);
+    int64MultiQueueDestroy(mq);
+    return true;
+}
+
+int main(void) {
+    Int64MultiQueue *mq = int64MultiQueueCreate(1, 2, 8);
+    if (!mq) {
+        fprintf(stderr, "Failed to create MultiQueue\n");
+        return EXIT_FAILURE;
+    }
+    MultiQueueRandom random = {42};
+    int64_t values[] = {5, 20, 110, 14, -21, -84, 3};
+    for (size_t i = 0; i < sizeof(values) / sizeof(*values); i++)
+        int64MultiQueuePush(mq, &random, values[i]);
+
+    // Pops are approximately ordered
+    int64_t value;
+    printf("Relaxed pop order:");
+    while (int64MultiQueuePop(mq, &random, &value))
+        printf(" %lld", (long long)value);
+    printf("\n");
+    int64MultiQueueDestroy(mq);
+
+    size_t threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+    size_t counts = sizeof(threadCounts) / sizeof(*threadCounts);
+
+    printf("\nThroughput, 50%% push / 50%% pop, 4 shards per thread:\n");
+    for (size_t i = 0; i < counts; i++)
+        printf("%2zu threads: %6.2f Mops/s\n", threadCounts[i],
+               measureThroughput(threadCounts[i], 4000000));
+
+    printf("\nRank error distribution (100k concurrent pops):\n");
+    for (size_t i = 0; i < counts; i++) {
+        if (!measureRankError(threadCounts[i], 100000))
+            return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,474 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Nodes are carved from blocks that double in size up to this many nodes
+#define PAIRING_FIRST_BLOCK 64
+#define PAIRING_MAX_BLOCK 65536
+
+// A heap node. `prev` points to the left sibling, or to the parent for the
+// first child, so a node can be cut out of its sibling list in O(1).
+typedef struct PairingNode {
+    int64_t key;
+    struct PairingNode *child;   // first (leftmost) child
+    struct PairingNode *sibling; // next sibling (free list link when unused)
+    struct PairingNode *prev;    // left sibling or parent
+} PairingNode;
+
+// A block of pooled nodes
+typedef struct PairingBlock {
+    struct PairingBlock *next;
+    size_t count;
+    PairingNode nodes[];
+} PairingBlock;
+
+// Meldable max pairing heap.
+// insert and meld are O(1), pop is amortized O(log n). Nodes come from
+// per-heap blocks, and melding splices the source heap's blocks and free list
+// into the destination, so melding never copies or re-inserts elements.
+typedef struct {
+    PairingNode *root;
+    size_t size;
+    PairingBlock *blocks;   // every block owned by this heap
+    PairingBlock *lastBlock;
+    PairingNode *freeList;  // recycled nodes, linked through `sibling`
+    PairingNode *freeTail;
+    PairingNode *bumpNext;  // unused tail of the newest block
+    PairingNode *bumpEnd;
+    PairingNode *spareRanges; // unused ranges parked by meld, see parkRange
+    PairingNode *spareTail;
+    size_t nextBlockSize;
+} Int64PairingHeap;
+
+// Link two trees, the smaller root becomes the first child of the larger
+static PairingNode *link(PairingNode *a, PairingNode *b) {
+    if (!a)
+        return b;
+    if (!b)
+        return a;
+    if (b->key > a->key) {
+        PairingNode *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    b->prev = a;
+    b->sibling = a->child;
+    if (a->child)
+        a->child->prev = b;
+    a->child = b;
+    a->sibling = NULL;
+    a->prev = NULL;
+    return a;
+}
+
+// Combine a sibling list into one tree with the standard two-pass pairing:
+// link pairs left to right, then fold the pairs right to left.
+static PairingNode *combineSiblings(PairingNode *first) {
+    if (!first)
+        return NULL;
+
+    // First pass: pair up, pushing each pair onto a reversed list
+    PairingNode *pairs = NULL;
+    while (first) {
+        PairingNode *a = first;
+        PairingNode *b = a->sibling;
+        first = b ? b->sibling : NULL;
+        a->sibling = a->prev = NULL;
+        if (b)
+            b->sibling = b->prev = NULL;
+        PairingNode *tree = link(a, b);
+        tree->sibling = pairs;
+        pairs = tree;
+    }
+
+    // Second pass: fold the pairs, the last pair first
+    PairingNode *result = pairs;
+    pairs = pairs->sibling;
+    result->sibling = NULL;
+    while (pairs) {
+        PairingNode *next = pairs->sibling;
+        pairs->sibling = NULL;
+        result = link(result, pairs);
+        pairs = next;
+    }
+    return result;
+}
+
+// Detach a non-root node (and its subtree) from its parent
+static void cut(PairingNode *node) {
+    if (node->prev->child == node)
+        node->prev->child = node->sibling; // first child
+    else
+        node->prev->sibling = node->sibling;
+    if (node->sibling)
+        node->sibling->prev = node->prev;
+    node->sibling = node->prev = NULL;
+}
+
+// Park the unused nodes [begin, end) for later allocation in O(1): the first
+// node stores the end of the range in `child` and links the next range
+// through `sibling`.
+static void parkRange(Int64PairingHeap *h, PairingNode *begin,
+                      PairingNode *end) {
+    if (begin == end)
+        return;
+    begin->child = end;
+    begin->sibling = NULL;
+    if (h->spareTail)
+        h->spareTail->sibling = begin;
+    else
+        h->spareRanges = begin;
+    h->spareTail = begin;
+}
+
+// Take a node from the free list, the current block or a parked range, adding
+// a block if all are exhausted
+static PairingNode *allocateNode(Int64PairingHeap *h) {
+    if (h->freeList) {
+        PairingNode *node = h->freeList;
+        h->freeList = node->sibling;
+        if (!h->freeList)
+            h->freeTail = NULL;
+        return node;
+    }
+    if (h->bumpNext == h->bumpEnd && h->spareRanges) {
+        PairingNode *range = h->spareRanges;
+        h->spareRanges = range->sibling;
+        if (!h->spareRanges)
+            h->spareTail = NULL;
+        h->bumpNext = range;
+        h->bumpEnd = range->child;
+    }
+    if (h->bumpNext == h->bumpEnd) {
+        size_t count = h->nextBlockSize;
+        PairingBlock *block =
+            malloc(sizeof(PairingBlock) + count * sizeof(PairingNode));
+        if (!block) {
+            fprintf(stderr, "Failed to allocate a block of %zu nodes\n",
+                    count);
+            return NULL;
+        }
+        block->next = NULL;
+        block->count = count;
+        if (h->lastBlock)
+            h->lastBlock->next = block;
+        else
+            h->blocks = block;
+        h->lastBlock = block;
+        h->bumpNext = block->nodes;
+        h->bumpEnd = block->nodes + count;
+        if (h->nextBlockSize < PAIRING_MAX_BLOCK)
+            h->nextBlockSize *= 2;
+    }
+    return h->bumpNext++;
+}
+
+// Put a node on the free list
+static void releaseNode(Int64PairingHeap *h, PairingNode *node) {
+    node->sibling = NULL;
+    if (h->freeTail)
+        h->freeTail->sibling = node;
+    else
+        h->freeList = node;
+    h->freeTail = node;
+}
+
+// Create a new, empty pairing heap
+Int64PairingHeap *int64PairingHeapCreate(void) {
+    Int64PairingHeap *h = calloc(1, sizeof(Int64PairingHeap));
+    if (!h) {
+        fprintf(stderr, "Failed to create Int64PairingHeap\n");
+        return NULL;
+    }
+    h->nextBlockSize = PAIRING_FIRST_BLOCK;
+    return h;
+}
+
+// Free the pairing heap memory, including every node block
+void int64PairingHeapDestroy(Int64PairingHeap *h) {
+    if (!h)
+        return;
+    PairingBlock *block = h->blocks;
+    while (block) {
+        PairingBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    free(h);
+}
+
+// Insert a new value into the heap in O(1).
+// Return a handle for int64PairingHeapUpdate, or NULL if allocation fails.
+// The handle stays valid until the value is popped.
+PairingNode *int64PairingHeapInsert(Int64PairingHeap *h, int64_t value) {
+    PairingNode *node = allocateNode(h);
+    if (!node)
+        return NULL;
+    node->key = value;
+    node->child = node->sibling = node->prev = NULL;
+    h->root = link(h->root, node);
+    h->size++;
+    return node;
+}
+
+// Peek the maximum value in the heap without removing it.
+int64_t int64PairingHeapPeek(const Int64PairingHeap *h) {
+    if (h->size == 0) {
+        fprintf(stderr, "Heap is empty\n");
+        exit(EXIT_FAILURE);
+    }
+    return h->root->key;
+}
+
+// Remove and return the maximum value from the heap.
+int64_t int64PairingHeapExtract(Int64PairingHeap *h) {
+    if (h->size == 0) {
+        fprintf(stderr, "Heap is empty\n");
+        exit(EXIT_FAILURE);
+    }
+    PairingNode *root = h->root;
+    int64_t value = root->key;
+    h->root = combineSiblings(root->child);
+    h->size--;
+    releaseNode(h, root);
+    return value;
+}
+
+// Change the value of a node in place.
+// Raising it (decrease-key of the min-heap formulation) cuts the node and
+// links it with the root in O(1); lowering it also re-pairs its children.
+void int64PairingHeapUpdate(Int64PairingHeap *h, PairingNode *node,
+                            int64_t value) {
+    int64_t old = node->key;
+    node->key = value;
+    if (value > old) {
+        if (node != h->root) {
+            cut(node);
+            h->root = link(h->root, node);
+        }
+    } else if (value < old) {
+        // Children may now be larger than the node: detach them
+        PairingNode *children = combineSiblings(node->child);
+        node->child = NULL;
+        if (node == h->root) {
+            h->root = link(node, children);
+        } else {
+            cut(node);
+            h->root = link(h->root, link(node, children));
+        }
+    }
+}
+
+// Meld `src` into `dst` in O(1): the roots are linked and src's node blocks
+// and free list move over to dst. `src` is left empty but still usable.
+void int64PairingHeapMeld(Int64PairingHeap *dst, Int64PairingHeap *src) {
+    if (dst == src)
+        return;
+    dst->root = link(dst->root, src->root);
+    dst->size += src->size;
+
+    // Blocks: dst now owns src's list
+    if (src->blocks) {
+        if (dst->lastBlock)
+            dst->lastBlock->next = src->blocks;
+        else
+            dst->blocks = src->blocks;
+        dst->lastBlock = src->lastBlock;
+    }
+
+    // Free nodes: splice src's list after dst's
+    if (src->freeList) {
+        if (dst->freeTail)
+            dst->freeTail->sibling = src->freeList;
+        else
+            dst->freeList = src->freeList;
+        dst->freeTail = src->freeTail;
+    }
+
+    // Parked ranges: splice src's list after dst's
+    if (src->spareRanges) {
+        if (dst->spareTail)
+            dst->spareTail->sibling = src->spareRanges;
+        else
+            dst->spareRanges = src->spareRanges;
+        dst->spareTail = src->spareTail;
+    }
+
+    // Keep bumping from the larger unused range and park the smaller one
+    PairingNode *next = src->bumpNext, *end = src->bumpEnd;
+    if (end - next > dst->bumpEnd - dst->bumpNext) {
+        next = dst->bumpNext;
+        end = dst->bumpEnd;
+        dst->bumpNext = src->bumpNext;
+        dst->bumpEnd = src->bumpEnd;
+    }
+    parkRange(dst, next, end);
+    if (src->nextBlockSize > dst->nextBlockSize)
+        dst->nextBlockSize = src->nextBlockSize;
+
+    src->root = NULL;
+    src->size = 0;
+    src->blocks = src->lastBlock = NULL;
+    src->freeList = src->freeTail = NULL;
+    src->bumpNext = src->bumpEnd = NULL;
+    src->spareRanges = src->spareTail = NULL;
+}
+
+// Build a pairing heap from an array heap's contents (e.g. the data/size of
+// an Int64MaxHeap) or any array, in O(n).
+Int64PairingHeap *int64PairingHeapFromArray(const int64_t *values,
+                                            size_t count) {
+    Int64PairingHeap *h = int64PairingHeapCreate();
+    if (!h)
+        return NULL;
+    for (size_t i = 0; i < count; i++) {
+        if (!int64PairingHeapInsert(h, values[i])) {
+            int64PairingHeapDestroy(h);
+            return NULL;
+        }
+    }
+    return h;
+}
+
+// Copy every value of the heap into `out` (room for size values) in O(n)
+// without modifying it. The values are in tree order, not sorted; feed them
+// to an array heap's Floyd heapify (int64MaxHeapFromArray) to convert back.
+size_t int64PairingHeapToArray(const Int64PairingHeap *h, int64_t *out) {
+    size_t count = 0;
+    PairingNode *node = h->root;
+    // Pre-order walk using the prev links instead of a stack
+    while (node) {
+        out[count++] = node->key;
+        if (node->child) {
+            node = node->child;
+            continue;
+        }
+        while (node && !node->sibling) {
+            // Climb to the parent: walk left to the first child
+            while (node->prev && node->prev->child != node)
+                node = node->prev;
+            node = node->prev;
+        }
+        if (node)
+            node = node->sibling;
+    }
+    return count;
+}
+
+bool int64PairingHeapIsEmpty(const Int64PairingHeap *h) {
+    return h->size == 0;
+}
+
+size_t int64PairingHeapSize(const Int64PairingHeap *h) { return h->size; }
+
+// ---------------------------------------------------------------------------
+// Benchmark: combining per-worker heaps
+// ---------------------------------------------------------------------------
+
+// Array max-heap insert, i.e. what merging Int64MaxHeaps costs today
+static void arrayHeapInsert(int64_t *data, size_t *size, int64_t value) {
+    size_t i = (*size)++;
+    while (i > 0 && data[(i - 1) / 2] < value) {
+        data[i] = data[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    data[i] = value;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Example usage
+int main(void) {
+    Int64PairingHeap *a = int64PairingHeapCreate();
+    Int64PairingHeap *b = int64PairingHeapCreate();
+    if (!a || !b)
+        return 1;
+
+    PairingNode *handles[10];
+    for (int i = 1; i <= 10; i++)
+        handles[i - 1] = int64PairingHeapInsert(i % 2 ? a : b, i * 10);
+
+    // Raise 10 (in a) above everything, lower 100 (in b) to the bottom
+    int64PairingHeapUpdate(a, handles[0], 1000);
+    int64PairingHeapUpdate(b, handles[9], -5);
+    int64PairingHeapMeld(a, b);
+    int64PairingHeapDestroy(b);
+
+    int64_t values[10];
+    size_t count = int64PairingHeapToArray(a, values);
+    printf("Melded heap holds %zu values\n", count);
+    printf("Heap outputs in descending order:\n");
+    while (!int64PairingHeapIsEmpty(a))
+        printf("%lld ", (long long)int64PairingHeapExtract(a));
+    printf("\n");
+    int64PairingHeapDestroy(a);
+
+    // Combine 8 worker heaps of 250K values each
+    size_t workers = 8, perWorker = 250000, total = workers * perWorker;
+    int64_t *source = malloc(total * sizeof(int64_t));
+    int64_t *merged = malloc(total * sizeof(int64_t));
+    if (!source || !merged) {
+        fprintf(stderr, "Failed to allocate the benchmark input\n");
+        free(source);
+        free(merged);
+        return 1;
+    }
+    uint64_t state = 88172645463325252ULL;
+    for (size_t i = 0; i < total; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        source[i] = (int64_t)state;
+    }
+
+    Int64PairingHeap *heaps[8];
+    for (size_t w = 0; w < workers; w++) {
+        heaps[w] = int64PairingHeapFromArray(source + w * perWorker, perWorker);
+        if (!heaps[w]) {
+            for (size_t v = 0; v < w; v++)
+                int64PairingHeapDestroy(heaps[v]);
+            free(source);
+            free(merged);
+            return 1;
+        }
+    }
+    double start = nowSeconds();
+    for (size_t w = 1; w < workers; w++) {
+        int64PairingHeapMeld(heaps[0], heaps[w]);
+        int64PairingHeapDestroy(heaps[w]);
+    }
+    double meldSeconds = nowSeconds() - start;
+
+    size_t mergedSize = 0;
+    start = nowSeconds();
+    for (size_t i = 0; i < total; i++)
+        arrayHeapInsert(merged, &mergedSize, source[i]);
+    double reinsertSeconds = nowSeconds() - start;
+
+    start = nowSeconds();
+    bool sorted = true;
+    int64_t previous = INT64_MAX;
+    while (!int64PairingHeapIsEmpty(heaps[0])) {
+        int64_t v = int64PairingHeapExtract(heaps[0]);
+        sorted &= v <= previous;
+        previous = v;
+    }
+    double drainSeconds = nowSeconds() - start;
+
+    printf("\nCombining %zu heaps of %zu values:\n", workers, perWorker);
+    printf("pairing heap meld       : %.6f s\n", meldSeconds);
+    printf("array heap re-insert    : %.3f s\n", reinsertSeconds);
+    printf("draining the melded heap: %.3f s, order %s\n", drainSeconds,
+           sorted ? "ok" : "WRONG");
+
+    int64PairingHeapDestroy(heaps[0]);
+    free(source);
+    free(merged);
+    return 0;
+}
@@ -0,0 +1,404 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// A {priority, payload} pair as seen by callers
+typedef struct {
+    int64_t priority;
+    void *payload;
+} Int64PriorityQueueEntry;
+
+// Max priority queue carrying a payload per priority.
+// The heap is stored as parallel arrays (struct-of-arrays), so sifting only
+// reads the packed priority array; sequence numbers are consulted on ties
+// and payloads are only written, never compared.
+typedef struct {
+    int64_t *priorities; // heap-ordered priorities
+    void **payloads;     // payload of the node at the same index
+    uint64_t *sequences; // insertion order per node (NULL if not stable)
+    size_t size;         // number of elements in the heap
+    size_t capacity;     // maximum number of elements in the heap
+    uint64_t nextSequence;
+} Int64PayloadPriorityQueue;
+
+// Index helpers
+static inline size_t getParentIndex(size_t i) { return (i - 1) / 2; }
+static inline size_t getLeftChildIndex(size_t i) { return 2 * i + 1; }
+
+// Does node a have to be popped before node b?
+// Equal priorities are ordered by sequence number (FIFO) in stable mode.
+static inline bool precedes(const Int64PayloadPriorityQueue *pq, size_t a,
+                            size_t b) {
+    if (pq->priorities[a] != pq->priorities[b])
+        return pq->priorities[a] > pq->priorities[b];
+    return pq->sequences && pq->sequences[a] < pq->sequences[b];
+}
+
+// Same as precedes(), against a value that is not stored in the heap
+static inline bool precedesValue(const Int64PayloadPriorityQueue *pq, size_t a,
+                                 int64_t priority, uint64_t sequence) {
+    if (pq->priorities[a] != priority)
+        return pq->priorities[a] > priority;
+    return pq->sequences && pq->sequences[a] < sequence;
+}
+
+// Does a value that is not stored in the heap have to be popped before node b?
+static inline bool valuePrecedes(const Int64PayloadPriorityQueue *pq,
+                                 int64_t priority, uint64_t sequence,
+                                 size_t b) {
+    if (priority != pq->priorities[b])
+        return priority > pq->priorities[b];
+    return pq->sequences && sequence < pq->sequences[b];
+}
+
+// Resize the underlying arrays
+static bool int64PayloadPriorityQueueResize(Int64PayloadPriorityQueue *pq,
+                                            size_t newCapacity) {
+    int64_t *newPriorities =
+        realloc(pq->priorities, newCapacity * sizeof(int64_t));
+    if (!newPriorities)
+        goto fail;
+    pq->priorities = newPriorities;
+
+    void **newPayloads = realloc(pq->payloads, newCapacity * sizeof(void *));
+    if (!newPayloads)
+        goto fail;
+    pq->payloads = newPayloads;
+
+    if (pq->sequences) {
+        uint64_t *newSequences =
+            realloc(pq->sequences, newCapacity * sizeof(uint64_t));
+        if (!newSequences)
+            goto fail;
+        pq->sequences = newSequences;
+    }
+
+    pq->capacity = newCapacity;
+    return true;
+
+fail:
+    // Arrays that were already grown stay valid for the old capacity
+    fprintf(stderr, "Memory (re)allocation failed for capacity %zu\n",
+            newCapacity);
+    return false;
+}
+
+// Create a new payload priority queue.
+// If stableOrder is true, elements with equal priorities pop in FIFO order.
+Int64PayloadPriorityQueue *
+int64PayloadPriorityQueueCreate(size_t initialCapacity, bool stableOrder) {
+    if (initialCapacity == 0) {
+        fprintf(stderr, "Initial capacity must be > 0 (got %zu)\n",
+                initialCapacity);
+        return NULL;
+    }
+
+    Int64PayloadPriorityQueue *pq = calloc(1, sizeof(*pq));
+    if (!pq) {
+        fprintf(stderr,
+                "Memory allocation failed for Int64PayloadPriorityQueue\n");
+        return NULL;
+    }
+
+    pq->priorities = calloc(initialCapacity, sizeof(*pq->priorities));
+    pq->payloads = calloc(initialCapacity, sizeof(*pq->payloads));
+    if (stableOrder)
+        pq->sequences = calloc(initialCapacity, sizeof(*pq->sequences));
+    if (!pq->priorities || !pq->payloads || (stableOrder && !pq->sequences)) {
+        fprintf(stderr, "Memory allocation failed for data arrays\n");
+        free(pq->priorities);
+        free(pq->payloads);
+        free(pq->sequences);
+        free(pq);
+        return NULL;
+    }
+
+    pq->size = 0;
+    pq->capacity = initialCapacity;
+    pq->nextSequence = 0;
+    return pq;
+}
+
+// Destroy the payload priority queue memory (payloads are not freed)
+void int64PayloadPriorityQueueDestroy(Int64PayloadPriorityQueue *pq) {
+    if (!pq)
+        return;
+    free(pq->priorities);
+    free(pq->payloads);
+    free(pq->sequences);
+    free(pq);
+}
+
+// Move node `from` into slot `to`
+static inline void moveNode(Int64PayloadPriorityQueue *pq, size_t to,
+                            size_t from) {
+    pq->priorities[to] = pq->priorities[from];
+    pq->payloads[to] = pq->payloads[from];
+    if (pq->sequences)
+        pq->sequences[to] = pq->sequences[from];
+}
+
+// Store an entry into slot i
+static inline void storeNode(Int64PayloadPriorityQueue *pq, size_t i,
+                             int64_t priority, void *payload,
+                             uint64_t sequence) {
+    pq->priorities[i] = priority;
+    pq->payloads[i] = payload;
+    if (pq->sequences)
+        pq->sequences[i] = sequence;
+}
+
+// Restore the max‐heap property moving the entry at node i up.
+// The entry is held aside and parents are shifted down into the hole, so its
+// payload is written once at its final position.
+static void heapifyUp(Int64PayloadPriorityQueue *pq, size_t i) {
+    int64_t priority = pq->priorities[i];
+    void *payload = pq->payloads[i];
+    uint64_t sequence = pq->sequences ? pq->sequences[i] : 0;
+
+    while (i > 0) {
+        size_t parent = getParentIndex(i);
+        if (!valuePrecedes(pq, priority, sequence, parent))
+            break;
+        moveNode(pq, i, parent);
+        i = parent;
+    }
+    storeNode(pq, i, priority, payload, sequence);
+}
+
+// Restore the max‐heap property moving the entry at node i down
+static void heapifyDown(Int64PayloadPriorityQueue *pq, size_t i) {
+    int64_t priority = pq->priorities[i];
+    void *payload = pq->payloads[i];
+    uint64_t sequence = pq->sequences ? pq->sequences[i] : 0;
+
+    while (true) {
+        size_t left = getLeftChildIndex(i);
+        if (left >= pq->size)
+            break;
+
+        // Pick the child that has to be popped first
+        size_t best = left;
+        size_t right = left + 1;
+        if (right < pq->size && precedes(pq, right, left))
+            best = right;
+        if (!precedesValue(pq, best, priority, sequence)) {
+            // The max-heap property is satisfied
+            break;
+        }
+
+        moveNode(pq, i, best);
+        i = best;
+    }
+    storeNode(pq, i, priority, payload, sequence);
+}
+
+// Push a payload with the given priority onto the queue.
+bool int64PayloadPriorityQueuePush(Int64PayloadPriorityQueue *pq,
+                                   int64_t priority, void *payload) {
+    if (pq->size + 1 > pq->capacity) {
+        if (!int64PayloadPriorityQueueResize(pq, pq->capacity * 2))
+            return false;
+    }
+
+    storeNode(pq, pq->size, priority, payload, pq->nextSequence++);
+    heapifyUp(pq, pq->size);
+    pq->size++;
+    return true;
+}
+
+// Pop the entry with the maximum priority from the queue.
+Int64PriorityQueueEntry
+int64PayloadPriorityQueuePop(Int64PayloadPriorityQueue *pq) {
+    if (pq->size == 0) {
+        fprintf(stderr, "Error: pop() called on empty priority queue\n");
+        exit(EXIT_FAILURE);
+    }
+
+    Int64PriorityQueueEntry root = {pq->priorities[0], pq->payloads[0]};
+    pq->size--;
+    if (pq->size > 0) {
+        moveNode(pq, 0, pq->size); // Move the last element to the root
+        heapifyDown(pq, 0);        // Restore the max-heap property
+    }
+
+    return root;
+}
+
+// Peek at the entry with the maximum priority without removing it.
+Int64PriorityQueueEntry
+int64PayloadPriorityQueuePeek(const Int64PayloadPriorityQueue *pq) {
+    if (pq->size == 0) {
+        fprintf(stderr, "Error: peek() called on empty priority queue\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return (Int64PriorityQueueEntry){pq->priorities[0], pq->payloads[0]};
+}
+
+// Check if the queue is empty.
+bool int64PayloadPriorityQueueIsEmpty(const Int64PayloadPriorityQueue *pq) {
+    return pq->size == 0;
+}
+
+// Get the size of the queue.
+size_t int64PayloadPriorityQueueSize(const Int64PayloadPriorityQueue *pq) {
+    return pq->size;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Bare int64_t binary max heap (as in int64PriorityQueue.c with arity 2),
+// the baseline that shows what carrying payloads costs
+typedef struct {
+    int64_t *data;
+    size_t size;
+    size_t capacity;
+} BareKeyHeap;
+
+static bool bareKeyHeapPush(BareKeyHeap *h, int64_t value) {
+    if (h->size == h->capacity) {
+        int64_t *data = realloc(h->data, 2 * h->capacity * sizeof(int64_t));
+        if (!data) {
+            fprintf(stderr, "Memory (re)allocation failed for capacity %zu\n",
+                    2 * h->capacity);
+            return false;
+        }
+        h->data = data;
+        h->capacity *= 2;
+    }
+    size_t i = h->size++;
+    while (i > 0 && h->data[getParentIndex(i)] < value) {
+        h->data[i] = h->data[getParentIndex(i)];
+        i = getParentIndex(i);
+    }
+    h->data[i] = value;
+    return true;
+}
+
+static int64_t bareKeyHeapPop(BareKeyHeap *h) {
+    int64_t root = h->data[0];
+    int64_t value = h->data[--h->size];
+    size_t i = 0;
+    while (true) {
+        size_t child = getLeftChildIndex(i);
+        if (child >= h->size)
+            break;
+        if (child + 1 < h->size && h->data[child + 1] > h->data[child])
+            child++;
+        if (h->data[child] <= value)
+            break;
+        h->data[i] = h->data[child];
+        i = child;
+    }
+    h->data[i] = value;
+    return root;
+}
+
+// Same workload as benchmarkQueue with keys only
+static void benchmarkBareKeys(size_t n) {
+    BareKeyHeap h = {malloc(1024 * sizeof(int64_t)), 0, 1024};
+    if (!h.data) {
+        fprintf(stderr, "Memory allocation failed for the baseline heap\n");
+        return;
+    }
+
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    double start = nowSeconds();
+    for (size_t i = 0; i < n; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        if (!bareKeyHeapPush(&h, (int64_t)(state % 1024))) {
+            free(h.data);
+            return;
+        }
+    }
+    double pushed = nowSeconds();
+
+    bool ordered = true;
+    int64_t previous = INT64_MAX;
+    while (h.size > 0) {
+        int64_t value = bareKeyHeapPop(&h);
+        ordered &= value <= previous;
+        previous = value;
+    }
+    double popped = nowSeconds();
+
+    printf("%-8s push %6.2f Mops/s, pop %6.2f Mops/s, order: %s\n",
+           "bare key", (double)n / (pushed - start) / 1e6,
+           (double)n / (popped - pushed) / 1e6, ordered ? "ok" : "WRONG");
+    free(h.data);
+}
+
+// Push n values drawn from a small priority range (many ties), then drain
+static void benchmarkQueue(bool stableOrder, size_t n) {
+    Int64PayloadPriorityQueue *pq =
+        int64PayloadPriorityQueueCreate(1024, stableOrder);
+    if (!pq)
+        return;
+
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    double start = nowSeconds();
+    for (size_t i = 0; i < n; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int64PayloadPriorityQueuePush(pq, (int64_t)(state % 1024),
+                                      (void *)(uintptr_t)i);
+    }
+    double pushed = nowSeconds();
+
+    // In stable mode, payloads (push indices) must rise within each priority
+    bool fifo = true;
+    Int64PriorityQueueEntry previous = {INT64_MAX, NULL};
+    while (!int64PayloadPriorityQueueIsEmpty(pq)) {
+        Int64PriorityQueueEntry e = int64PayloadPriorityQueuePop(pq);
+        if (e.priority == previous.priority && e.payload < previous.payload)
+            fifo = false;
+        previous = e;
+    }
+    double popped = nowSeconds();
+
+    printf("%-8s push %6.2f Mops/s, pop %6.2f Mops/s, FIFO ties: %s\n",
+           stableOrder ? "stable" : "unstable",
+           (double)n / (pushed - start) / 1e6,
+           (double)n / (popped - pushed) / 1e6, fifo ? "yes" : "no");
+    int64PayloadPriorityQueueDestroy(pq);
+}
+
+int main(void) {
+    Int64PayloadPriorityQueue *pq = int64PayloadPriorityQueueCreate(4, true);
+    if (!pq) {
+        fprintf(stderr, "Failed to create priority queue\n");
+        return EXIT_FAILURE;
+    }
+
+    // Jobs with equal priorities come out in submission order
+    const char *jobs[] = {"backup", "email",  "report", "deploy",
+                          "index",  "resize", "audit"};
+    int64_t priorities[] = {1, 5, 3, 5, 1, 5, 3};
+    for (size_t i = 0; i < sizeof(jobs) / sizeof(*jobs); i++)
+        int64PayloadPriorityQueuePush(pq, priorities[i], (void *)jobs[i]);
+
+    printf("Next job: %s\n",
+           (const char *)int64PayloadPriorityQueuePeek(pq).payload);
+    while (!int64PayloadPriorityQueueIsEmpty(pq)) {
+        Int64PriorityQueueEntry e = int64PayloadPriorityQueuePop(pq);
+        printf("Popped priority %lld: %s\n", (long long)e.priority,
+               (const char *)e.payload);
+    }
+    int64PayloadPriorityQueueDestroy(pq);
+
+    printf("\nThroughput with 4M values over 1024 priorities:\n");
+    benchmarkBareKeys(4000000);
+    benchmarkQueue(false, 4000000);
+    benchmarkQueue(true, 4000000);
+    return EXIT_SUCCESS;
+}
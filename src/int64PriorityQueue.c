@@ -2,17 +2,35 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_KERNELS 1
+#endif
+
+// Heap arrays of d-ary queues are laid out so that every group of siblings
+// starts on a cache line boundary (64 bytes = 8 int64_t values).
+#define CACHE_LINE_SIZE 64
+#define CACHE_LINE_INT64S (CACHE_LINE_SIZE / sizeof(int64_t))
 
 typedef struct {
     int64_t *data;   // heap array
     size_t size;     // number of elements in the heap
     size_t capacity; // maximum number of elements in the heap
+    size_t arity;    // number of children per node (2, 4 or 8)
+    int64_t *block;  // allocation backing data (data may point inside it)
 } Int64PriorityQueue;
 
 // Index helpers
-static inline size_t getParentIndex(size_t i) { return (i - 1) / 2; }
-static inline size_t getLeftChildIndex(size_t i) { return 2 * i + 1; }
-static inline size_t getRightChildIndex(size_t i) { return 2 * i + 2; }
+static inline size_t getParentIndex(const Int64PriorityQueue *pq, size_t i) {
+    return (i - 1) / pq->arity;
+}
+static inline size_t getFirstChildIndex(const Int64PriorityQueue *pq,
+                                        size_t i) {
+    return pq->arity * i + 1;
+}
 
 // Swap two elements in the heap
 static inline void int64Swap(int64_t *a, int64_t *b) {
@@ -21,28 +39,74 @@ static inline void int64Swap(int64_t *a, int64_t *b) {
     *b = tmp;
 }
 
+// Allocate a heap array for the given arity.
+// Binary heaps use a plain array. For d-ary heaps the children of node i start
+// at index d*i + 1, so the array is shifted by one slot less than a cache line
+// inside a 64-byte aligned block: data[1] then lands on a line boundary and
+// every sibling group (d = 4 or 8) sits inside a single cache line.
+static int64_t *int64PriorityQueueAllocate(size_t arity, size_t capacity,
+                                           int64_t **block) {
+    if (arity == 2) {
+        *block = malloc(capacity * sizeof(int64_t));
+        return *block;
+    }
+
+    size_t bytes = (capacity + CACHE_LINE_INT64S - 1) * sizeof(int64_t);
+    bytes = (bytes + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+    *block = aligned_alloc(CACHE_LINE_SIZE, bytes);
+    if (!*block)
+        return NULL;
+    return *block + (CACHE_LINE_INT64S - 1);
+}
+
 // Resize the underlying array
 static bool int64PriorityQueueResize(Int64PriorityQueue *pq,
                                      size_t newCapacity) {
-    int64_t *newData = realloc(pq->data, newCapacity * sizeof(int64_t));
+    if (pq->arity == 2) {
+        int64_t *newData = realloc(pq->block, newCapacity * sizeof(int64_t));
+        if (!newData) {
+            fprintf(stderr, "Memory (re)allocation failed for capacity %zu\n",
+                    newCapacity);
+            return false;
+        }
+
+        pq->data = pq->block = newData;
+        pq->capacity = newCapacity;
+        return true;
+    }
+
+    // aligned_alloc() has no realloc() counterpart, so move the data by hand
+    int64_t *newBlock;
+    int64_t *newData =
+        int64PriorityQueueAllocate(pq->arity, newCapacity, &newBlock);
     if (!newData) {
         fprintf(stderr, "Memory (re)allocation failed for capacity %zu\n",
                 newCapacity);
         return false;
     }
+    memcpy(newData, pq->data, pq->size * sizeof(int64_t));
+    free(pq->block);
 
     pq->data = newData;
+    pq->block = newBlock;
     pq->capacity = newCapacity;
     return true;
 }
 
-// Create a new int64_t priority queue
-Int64PriorityQueue *int64PriorityQueueCreate(size_t initialCapacity) {
+// Create a new int64_t priority queue whose nodes have `arity` children.
+// Wider nodes (4 or 8) make the tree shallower, and since each sibling group
+// fills at most one cache line, a sift-down costs one cache miss per level.
+Int64PriorityQueue *int64PriorityQueueCreateWithArity(size_t initialCapacity,
+                                                      size_t arity) {
     if (initialCapacity == 0) {
         fprintf(stderr, "Initial capacity must be > 0 (got %zu)\n",
                 initialCapacity);
         return NULL;
     }
+    if (arity != 2 && arity != 4 && arity != 8) {
+        fprintf(stderr, "Arity must be 2, 4 or 8 (got %zu)\n", arity);
+        return NULL;
+    }
 
     Int64PriorityQueue *pq = calloc(1, sizeof(*pq));
     if (!pq) {
@@ -50,7 +114,7 @@ Int64PriorityQueue *int64PriorityQueueCreate(size_t initialCapacity) {
         return NULL;
     }
 
-    pq->data = calloc(initialCapacity, sizeof(*pq->data));
+    pq->data = int64PriorityQueueAllocate(arity, initialCapacity, &pq->block);
     if (!pq->data) {
         fprintf(stderr, "Memory allocation failed for data array\n");
         free(pq);
@@ -59,21 +123,27 @@ Int64PriorityQueue *int64PriorityQueueCreate(size_t initialCapacity) {
 
     pq->size = 0;
     pq->capacity = initialCapacity;
+    pq->arity = arity;
     return pq;
 }
 
+// Create a new int64_t priority queue (binary heap)
+Int64PriorityQueue *int64PriorityQueueCreate(size_t initialCapacity) {
+    return int64PriorityQueueCreateWithArity(initialCapacity, 2);
+}
+
 // Destroy the int64_t priority queue memory
 void int64PriorityQueueDestroy(Int64PriorityQueue *pq) {
     if (!pq)
         return;
-    free(pq->data);
+    free(pq->block);
     free(pq);
 }
 
 // Restore the max‐heap property moving node i up
 static void heapifyUp(Int64PriorityQueue *pq, size_t i) {
     while (i > 0) {
-        size_t parent = getParentIndex(i);
+        size_t parent = getParentIndex(pq, i);
         if (pq->data[parent] >= pq->data[i])
             break;
         int64Swap(&pq->data[parent], &pq->data[i]);
@@ -81,26 +151,194 @@ static void heapifyUp(Int64PriorityQueue *pq, size_t i) {
     }
 }
 
+#ifdef HAVE_X86_KERNELS
+// Index of the largest of a full group of 4 or 8 siblings with AVX2: a max
+// tree built from 64-bit compares and blends, then a compare-equal against
+// the broadcast maximum whose movemask gives the winning lane.
+__attribute__((target("avx2"))) static size_t
+maxSiblingIndexAvx2(const int64_t *children, size_t arity) {
+    __m256i max = _mm256_load_si256((const __m256i *)children);
+    __m256i hi = max;
+    if (arity == 8) {
+        hi = _mm256_load_si256((const __m256i *)(children + 4));
+        max = _mm256_blendv_epi8(max, hi, _mm256_cmpgt_epi64(hi, max));
+    }
+    // Reduce the 4 lanes to a broadcast maximum
+    __m256i swapped = _mm256_permute4x64_epi64(max, 0x4E);
+    max = _mm256_blendv_epi8(max, swapped, _mm256_cmpgt_epi64(swapped, max));
+    swapped = _mm256_shuffle_epi32(max, 0x4E);
+    max = _mm256_blendv_epi8(max, swapped, _mm256_cmpgt_epi64(swapped, max));
+
+    __m256i lo = _mm256_load_si256((const __m256i *)children);
+    unsigned mask = (unsigned)_mm256_movemask_pd(
+        _mm256_castsi256_pd(_mm256_cmpeq_epi64(lo, max)));
+    if (arity == 8)
+        mask |= (unsigned)_mm256_movemask_pd(
+                    _mm256_castsi256_pd(_mm256_cmpeq_epi64(hi, max)))
+                << 4;
+    return (size_t)__builtin_ctz(mask);
+}
+#endif
+
+// Set before main() runs when the CPU supports AVX2
+static bool useAvx2Siblings = false;
+
+__attribute__((constructor)) static void selectSiblingKernel(void) {
+#ifdef HAVE_X86_KERNELS
+    __builtin_cpu_init();
+    useAvx2Siblings = __builtin_cpu_supports("avx2");
+#endif
+}
+
+// Return the index (0..count-1) of the largest of `count` siblings.
+// Full groups of 4 or 8 go to the AVX2 kernel when the CPU has it.
+static inline size_t maxSiblingIndex(const int64_t *children, size_t count,
+                                     size_t arity) {
+#ifdef HAVE_X86_KERNELS
+    if (useAvx2Siblings && count == arity && arity >= 4)
+        return maxSiblingIndexAvx2(children, arity);
+#else
+    (void)arity;
+#endif
+    size_t largest = 0;
+    for (size_t k = 1; k < count; k++) {
+        if (children[k] > children[largest])
+            largest = k;
+    }
+    return largest;
+}
+
 // Restore the max‐heap property moving node i down
 static void heapifyDown(Int64PriorityQueue *pq, size_t i) {
+    if (pq->arity == 2) {
+        while (true) {
+            size_t left = getFirstChildIndex(pq, i);
+            size_t right = left + 1;
+            size_t largest = i;
+
+            // Check if left child exists and is greater than current largest
+            if (left < pq->size && pq->data[left] > pq->data[largest])
+                largest = left;
+            if (right < pq->size && pq->data[right] > pq->data[largest])
+                largest = right;
+            if (largest == i) {
+                // The max-heap property is satisfied
+                break;
+            }
+
+            int64Swap(&pq->data[i], &pq->data[largest]);
+            i = largest;
+        }
+        return;
+    }
+
+    // d-ary: pick the largest sibling of the (cache-line aligned) group, then
+    // move the sifted value down as a hole instead of swapping at each level
+    int64_t value = pq->data[i];
     while (true) {
-        size_t left = getLeftChildIndex(i);
-        size_t right = getRightChildIndex(i);
-        size_t largest = i;
-
-        // Check if left child exists and is greater than current largest
-        if (left < pq->size && pq->data[left] > pq->data[largest])
-            largest = left;
-        if (right < pq->size && pq->data[right] > pq->data[largest])
-            largest = right;
-        if (largest == i) {
+        size_t first = getFirstChildIndex(pq, i);
+        if (first >= pq->size)
+            break;
+
+        size_t count = pq->size - first;
+        if (count > pq->arity)
+            count = pq->arity;
+        size_t largest =
+            first + maxSiblingIndex(&pq->data[first], count, pq->arity);
+        if (pq->data[largest] <= value) {
             // The max-heap property is satisfied
             break;
         }
 
-        int64Swap(&pq->data[i], &pq->data[largest]);
+        pq->data[i] = pq->data[largest];
         i = largest;
     }
+    pq->data[i] = value;
+}
+
+// Rebuild the max-heap property over the whole array in O(n) time
+// (Floyd's bottom-up heapify). Leaves are already heaps, so start at the last
+// internal node and sift each subtree root down.
+static void heapifyAll(Int64PriorityQueue *pq) {
+    if (pq->size < 2)
+        return;
+    for (size_t i = getParentIndex(pq, pq->size - 1) + 1; i-- > 0;)
+        heapifyDown(pq, i);
+}
+
+// Create a priority queue from an existing array in O(n) time.
+// If takeOwnership is true, `values` must come from malloc()/realloc() and is
+// adopted as the heap array (it must not be used or freed by the caller
+// afterwards); otherwise the values are copied. The result is a binary heap.
+Int64PriorityQueue *int64PriorityQueueFromArray(int64_t *values, size_t count,
+                                                bool takeOwnership) {
+    size_t capacity = count > 0 ? count : 1;
+    Int64PriorityQueue *pq;
+
+    if (takeOwnership) {
+        pq = calloc(1, sizeof(*pq));
+        if (!pq) {
+            fprintf(stderr,
+                    "Memory allocation failed for Int64PriorityQueue\n");
+            return NULL;
+        }
+        pq->data = pq->block = values;
+        pq->capacity = count;
+        pq->arity = 2;
+        if (!values || count == 0) {
+            // Nothing to adopt, make sure the queue owns a usable buffer
+            if (!int64PriorityQueueResize(pq, capacity)) {
+                free(pq);
+                return NULL;
+            }
+        }
+    } else {
+        pq = int64PriorityQueueCreate(capacity);
+        if (!pq)
+            return NULL;
+        if (count > 0)
+            memcpy(pq->data, values, count * sizeof(int64_t));
+    }
+
+    pq->size = count;
+    heapifyAll(pq);
+    return pq;
+}
+
+// Push a batch of values onto the queue.
+// Small batches are sifted up one by one (O(k log n)); large batches are
+// appended and the whole heap is rebuilt in O(n + k), which is cheaper once
+// k * log2(n + k) exceeds n + k.
+bool int64PriorityQueuePushMany(Int64PriorityQueue *pq, const int64_t *values,
+                                size_t count) {
+    if (count == 0)
+        return true;
+
+    size_t total = pq->size + count;
+    if (total > pq->capacity) {
+        size_t newCapacity = pq->capacity;
+        while (newCapacity < total)
+            newCapacity *= 2;
+        if (!int64PriorityQueueResize(pq, newCapacity))
+            return false;
+    }
+
+    size_t depth = 0;
+    for (size_t n = total; n > 1; n >>= 1)
+        depth++;
+
+    if (count * depth <= total) {
+        for (size_t i = 0; i < count; i++) {
+            pq->data[pq->size] = values[i];
+            heapifyUp(pq, pq->size);
+            pq->size++;
+        }
+    } else {
+        memcpy(pq->data + pq->size, values, count * sizeof(int64_t));
+        pq->size = total;
+        heapifyAll(pq);
+    }
+    return true;
 }
 
 // Push a value onto the queue.
@@ -143,12 +381,263 @@ int64_t int64PriorityQueuePeek(Int64PriorityQueue *pq) {
     return pq->data[0];
 }
 
+// Entry of the auxiliary frontier heap used by int64PriorityQueuePopMany
+typedef struct {
+    int64_t value;
+    size_t index; // position in the main heap array
+} FrontierEntry;
+
+static void frontierPush(FrontierEntry *f, size_t *size, FrontierEntry e) {
+    size_t i = (*size)++;
+    while (i > 0 && f[(i - 1) / 2].value < e.value) {
+        f[i] = f[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    f[i] = e;
+}
+
+static FrontierEntry frontierPop(FrontierEntry *f, size_t *size) {
+    FrontierEntry top = f[0];
+    FrontierEntry last = f[--*size];
+    size_t i = 0;
+    while (true) {
+        size_t c = 2 * i + 1;
+        if (c >= *size)
+            break;
+        if (c + 1 < *size && f[c + 1].value > f[c].value)
+            c++;
+        if (f[c].value <= last.value)
+            break;
+        f[i] = f[c];
+        i = c;
+    }
+    if (*size > 0)
+        f[i] = last;
+    return top;
+}
+
+// Depth of node i (the root has depth 0)
+static size_t heapDepth(const Int64PriorityQueue *pq, size_t i) {
+    size_t depth = 0;
+    for (; i > 0; i = getParentIndex(pq, i))
+        depth++;
+    return depth;
+}
+
+// Number of independent sift-downs advanced together by heapifyDownGroup
+#define SIFT_GROUP_SIZE 16
+
+// Sift down several nodes with disjoint subtrees in lockstep, one level per
+// round, prefetching each node's next children so the misses of the whole
+// group are in flight at once rather than one after another.
+static void heapifyDownGroup(Int64PriorityQueue *pq, const size_t *nodes,
+                             size_t count) {
+    size_t position[SIFT_GROUP_SIZE];
+    int64_t value[SIFT_GROUP_SIZE];
+    for (size_t j = 0; j < count; j++) {
+        position[j] = nodes[j];
+        value[j] = pq->data[nodes[j]];
+    }
+
+    size_t active = count;
+    while (active > 0) {
+        for (size_t j = 0; j < active;) {
+            size_t i = position[j];
+            size_t first = getFirstChildIndex(pq, i);
+            size_t largest = first;
+            if (first < pq->size) {
+                size_t siblings = pq->size - first;
+                if (siblings > pq->arity)
+                    siblings = pq->arity;
+                largest += maxSiblingIndex(&pq->data[first], siblings,
+                                           pq->arity);
+            }
+            if (first >= pq->size || pq->data[largest] <= value[j]) {
+                // Settled: store the value and retire the slot
+                pq->data[i] = value[j];
+                active--;
+                position[j] = position[active];
+                value[j] = value[active];
+                continue;
+            }
+            pq->data[i] = pq->data[largest];
+            position[j] = largest;
+            if (getFirstChildIndex(pq, largest) < pq->size)
+                __builtin_prefetch(
+                    &pq->data[getFirstChildIndex(pq, largest)]);
+            j++;
+        }
+    }
+}
+
+static int compareIndex(const void *a, const void *b) {
+    size_t x = *(const size_t *)a, y = *(const size_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Pop up to k maximum values into `out` in descending order and return how
+// many were popped.
+// The top k are found without touching the heap: a small frontier heap starts
+// at the root and, each time it yields a node, admits that node's children,
+// so only O(k * arity) nodes of the root region are ever compared. The
+// selected positions form a subtree containing the root; each is refilled
+// from the tail of the array and the refilled positions are sifted down from
+// the deepest up, restoring the heap in one O(k log n) pass instead of k
+// separate root-to-leaf sifts.
+size_t int64PriorityQueuePopMany(Int64PriorityQueue *pq, size_t k,
+                                 int64_t *out) {
+    if (k > pq->size)
+        k = pq->size;
+    if (k == 0)
+        return 0;
+
+    FrontierEntry *frontier =
+        malloc((1 + k * (pq->arity - 1)) * sizeof(FrontierEntry));
+    size_t *holes = malloc(k * sizeof(size_t));
+    if (!frontier || !holes) {
+        // Fall back to popping one at a time
+        free(frontier);
+        free(holes);
+        for (size_t i = 0; i < k; i++)
+            out[i] = int64PriorityQueuePop(pq);
+        return k;
+    }
+
+    size_t frontierSize = 0;
+    frontierPush(frontier, &frontierSize, (FrontierEntry){pq->data[0], 0});
+    for (size_t i = 0; i < k; i++) {
+        FrontierEntry e = frontierPop(frontier, &frontierSize);
+        out[i] = e.value;
+        holes[i] = e.index;
+        size_t first = getFirstChildIndex(pq, e.index);
+        for (size_t c = first; c < first + pq->arity && c < pq->size; c++)
+            frontierPush(frontier, &frontierSize,
+                         (FrontierEntry){pq->data[c], c});
+    }
+    free(frontier);
+
+    // Holes below the new size are refilled with the non-hole values that sit
+    // beyond it; both sequences are walked in ascending index order
+    qsort(holes, k, sizeof(size_t), compareIndex);
+    size_t newSize = pq->size - k;
+    size_t fillable = 0;
+    while (fillable < k && holes[fillable] < newSize)
+        fillable++;
+    size_t tail = newSize, nextHole = fillable;
+    for (size_t i = 0; i < fillable; i++) {
+        while (nextHole < k && holes[nextHole] == tail) {
+            nextHole++;
+            tail++;
+        }
+        pq->data[holes[i]] = pq->data[tail++];
+    }
+    pq->size = newSize;
+
+    // Every ancestor of a hole is a hole, so sifting the deepest level first
+    // sees valid heaps below each refilled position (Floyd on the root
+    // subtree). Holes on one level have disjoint subtrees, so they are sifted
+    // in interleaved groups whose cache misses overlap.
+    size_t end = fillable;
+    while (end > 0) {
+        size_t depth = heapDepth(pq, holes[end - 1]);
+        size_t begin = end - 1;
+        while (begin > 0 && heapDepth(pq, holes[begin - 1]) == depth)
+            begin--;
+        for (size_t g = begin; g < end; g += SIFT_GROUP_SIZE) {
+            size_t count = end - g < SIFT_GROUP_SIZE ? end - g
+                                                     : SIFT_GROUP_SIZE;
+            heapifyDownGroup(pq, &holes[g], count);
+        }
+        end = begin;
+    }
+    free(holes);
+    return k;
+}
+
 // Check if the queue is empty.
 bool int64PriorityQueueIsEmpty(Int64PriorityQueue *pq) { return pq->size == 0; }
 
 // Get the size of the queue.
 size_t int64PriorityQueueSize(Int64PriorityQueue *pq) { return pq->size; }
 
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Push n pseudo-random values, then pop them all, checking the order
+static void benchmarkArity(size_t arity, size_t n) {
+    Int64PriorityQueue *pq = int64PriorityQueueCreateWithArity(1024, arity);
+    if (!pq)
+        return;
+
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    double start = nowSeconds();
+    for (size_t i = 0; i < n; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int64PriorityQueuePush(pq, (int64_t)state);
+    }
+    double pushed = nowSeconds();
+
+    bool sorted = true;
+    int64_t previous = INT64_MAX;
+    while (!int64PriorityQueueIsEmpty(pq)) {
+        int64_t v = int64PriorityQueuePop(pq);
+        sorted &= v <= previous;
+        previous = v;
+    }
+    double popped = nowSeconds();
+
+    printf("arity %zu: push %6.2f Mops/s, pop %6.2f Mops/s (%.0f ns/pop)%s\n",
+           arity, (double)n / (pushed - start) / 1e6,
+           (double)n / (popped - pushed) / 1e6,
+           (popped - pushed) * 1e9 / (double)n, sorted ? "" : "  UNSORTED");
+    int64PriorityQueueDestroy(pq);
+}
+
+// Drain k values per tick with PopMany and with k single pops
+static void benchmarkPopMany(size_t arity, size_t n, size_t k, size_t ticks) {
+    Int64PriorityQueue *batched = int64PriorityQueueCreateWithArity(n, arity);
+    Int64PriorityQueue *single = int64PriorityQueueCreateWithArity(n, arity);
+    int64_t *out = malloc(k * sizeof(int64_t));
+    if (!batched || !single || !out)
+        return;
+
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < n; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int64PriorityQueuePush(batched, (int64_t)(state >> 1));
+        int64PriorityQueuePush(single, (int64_t)(state >> 1));
+    }
+
+    bool match = true;
+    double singleSeconds = 0, batchedSeconds = 0;
+    for (size_t t = 0; t < ticks; t++) {
+        double start = nowSeconds();
+        size_t got = int64PriorityQueuePopMany(batched, k, out);
+        double middle = nowSeconds();
+        for (size_t i = 0; i < got; i++)
+            match &= int64PriorityQueuePop(single) == out[i];
+        double end = nowSeconds();
+        batchedSeconds += middle - start;
+        singleSeconds += end - middle;
+    }
+
+    double popped = (double)(k * ticks);
+    printf("arity %zu: %zu x pop %5.1f ns/elem, popMany(%zu) %5.1f ns/elem "
+           "(%s)\n",
+           arity, k, singleSeconds * 1e9 / popped, k,
+           batchedSeconds * 1e9 / popped, match ? "same order" : "MISMATCH");
+    free(out);
+    int64PriorityQueueDestroy(batched);
+    int64PriorityQueueDestroy(single);
+}
+
 int main(void) {
     Int64PriorityQueue *pq = int64PriorityQueueCreate(8);
     if (!pq) {
@@ -172,5 +661,49 @@ int main(void) {
     printf("\n");
 
     int64PriorityQueueDestroy(pq);
+
+    // Bulk construction: heapify an owned array in O(n)
+    size_t count = 16;
+    int64_t *values = malloc(count * sizeof(int64_t));
+    if (!values)
+        return EXIT_FAILURE;
+    for (size_t i = 0; i < count; i++)
+        values[i] = (int64_t)((i * 37) % 23) - 11;
+    pq = int64PriorityQueueFromArray(values, count, true);
+    if (!pq) {
+        free(values);
+        return EXIT_FAILURE;
+    }
+
+    // A batch larger than the heap is appended and re-heapified at once
+    int64_t batch[] = {100, -100, 42, 7, 7, 0, 55, 13,
+                       -9,  21,   64, 1, 2, 3, 99, -1, 8};
+    int64PriorityQueuePushMany(pq, batch, sizeof(batch) / sizeof(*batch));
+
+    int64_t top[5];
+    size_t got = int64PriorityQueuePopMany(pq, 5, top);
+    printf("Top %zu of the bulk-loaded queue:", got);
+    for (size_t i = 0; i < got; i++)
+        printf(" %ld", top[i]);
+    printf("\n");
+
+    printf("Remaining %zu values in descending order:\n",
+           int64PriorityQueueSize(pq));
+    while (!int64PriorityQueueIsEmpty(pq))
+        printf("%ld ", int64PriorityQueuePop(pq));
+    printf("\n");
+
+    int64PriorityQueueDestroy(pq);
+
+    // Throughput of each heap arity on a queue much larger than the caches
+    printf("\nPush/pop throughput with 8M random values:\n");
+    benchmarkArity(2, 8000000);
+    benchmarkArity(4, 8000000);
+    benchmarkArity(8, 8000000);
+
+    // Dispatcher pattern: drain the best 1000 of 4M values per tick
+    printf("\nDraining 1000 values per tick from 4M values, 1000 ticks:\n");
+    benchmarkPopMany(2, 4000000, 1000, 1000);
+    benchmarkPopMany(4, 4000000, 1000, 1000);
     return EXIT_SUCCESS;
 }
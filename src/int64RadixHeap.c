@@ -0,0 +1,302 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// One bucket per possible highest differing bit, plus bucket 0 for keys equal
+// to the last extracted key
+#define RADIX_HEAP_BUCKETS 65
+
+// A growable bucket of keys
+typedef struct {
+    uint64_t *keys;
+    size_t size;
+    size_t capacity;
+} RadixBucket;
+
+// Monotone min priority queue (radix heap).
+// Valid when every pushed key is >= the last popped key, which holds for
+// Dijkstra and discrete event simulation. A key lives in the bucket given by
+// the highest bit in which it differs from the last popped key, so each key
+// moves to a lower bucket at most 64 times: O(log C) amortized per key and
+// almost no comparisons.
+typedef struct {
+    RadixBucket buckets[RADIX_HEAP_BUCKETS];
+    uint64_t last; // last extracted key (order-preserving encoding)
+    size_t size;   // number of elements in the heap
+} Int64RadixHeap;
+
+// Map int64_t to uint64_t preserving order (flip the sign bit)
+static inline uint64_t encodeKey(int64_t key) {
+    return (uint64_t)key ^ (1ULL << 63);
+}
+static inline int64_t decodeKey(uint64_t key) {
+    return (int64_t)(key ^ (1ULL << 63));
+}
+
+// Bucket index: 0 if equal to `last`, else 1 + position of highest set bit
+static inline size_t bucketIndex(uint64_t key, uint64_t last) {
+    uint64_t diff = key ^ last;
+    return diff == 0 ? 0 : (size_t)(64 - __builtin_clzll(diff));
+}
+
+// Append a key to a bucket, doubling its capacity when full
+static bool radixBucketAppend(RadixBucket *b, uint64_t key) {
+    if (b->size == b->capacity) {
+        size_t newCapacity = b->capacity ? b->capacity * 2 : 16;
+        uint64_t *newKeys = realloc(b->keys, newCapacity * sizeof(uint64_t));
+        if (!newKeys) {
+            fprintf(stderr, "Memory (re)allocation failed for capacity %zu\n",
+                    newCapacity);
+            return false;
+        }
+        b->keys = newKeys;
+        b->capacity = newCapacity;
+    }
+    b->keys[b->size++] = key;
+    return true;
+}
+
+// Create a new radix heap. Buckets allocate lazily on first use.
+Int64RadixHeap *int64RadixHeapCreate(void) {
+    Int64RadixHeap *h = calloc(1, sizeof(*h));
+    if (!h) {
+        fprintf(stderr, "Memory allocation failed for Int64RadixHeap\n");
+        return NULL;
+    }
+    h->last = encodeKey(INT64_MIN);
+    return h;
+}
+
+// Destroy the radix heap memory
+void int64RadixHeapDestroy(Int64RadixHeap *h) {
+    if (!h)
+        return;
+    for (size_t i = 0; i < RADIX_HEAP_BUCKETS; i++)
+        free(h->buckets[i].keys);
+    free(h);
+}
+
+// Push a key onto the heap.
+// Return false if the key is smaller than the last popped key (monotonicity
+// violated) or if memory allocation fails.
+bool int64RadixHeapPush(Int64RadixHeap *h, int64_t value) {
+    uint64_t key = encodeKey(value);
+    if (key < h->last) {
+        fprintf(stderr,
+                "Error: push(%ld) is below the last popped key %ld\n", value,
+                decodeKey(h->last));
+        return false;
+    }
+    if (!radixBucketAppend(&h->buckets[bucketIndex(key, h->last)], key))
+        return false;
+    h->size++;
+    return true;
+}
+
+// Refill bucket 0 if it is empty: take the lowest non-empty bucket, make its
+// minimum the new `last`, and redistribute its keys into lower buckets.
+static void radixHeapRefill(Int64RadixHeap *h) {
+    if (h->buckets[0].size > 0)
+        return;
+
+    size_t i = 1;
+    while (h->buckets[i].size == 0)
+        i++;
+
+    RadixBucket *b = &h->buckets[i];
+    uint64_t min = b->keys[0];
+    for (size_t j = 1; j < b->size; j++) {
+        if (b->keys[j] < min)
+            min = b->keys[j];
+    }
+
+    // Every key of bucket i shares the bits above i with the new `last`, so
+    // each one lands in a bucket strictly below i
+    h->last = min;
+    for (size_t j = 0; j < b->size; j++) {
+        uint64_t key = b->keys[j];
+        if (!radixBucketAppend(&h->buckets[bucketIndex(key, min)], key)) {
+            fprintf(stderr, "Error: failed to redistribute radix bucket\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    b->size = 0;
+}
+
+// Pop the minimum key from the heap.
+int64_t int64RadixHeapPop(Int64RadixHeap *h) {
+    if (h->size == 0) {
+        fprintf(stderr, "Error: pop() called on empty radix heap\n");
+        exit(EXIT_FAILURE);
+    }
+
+    radixHeapRefill(h);
+    h->size--;
+    h->buckets[0].size--;
+    return decodeKey(h->last);
+}
+
+// Peek at the minimum key without removing it.
+int64_t int64RadixHeapPeek(Int64RadixHeap *h) {
+    if (h->size == 0) {
+        fprintf(stderr, "Error: peek() called on empty radix heap\n");
+        exit(EXIT_FAILURE);
+    }
+
+    radixHeapRefill(h);
+    return decodeKey(h->last);
+}
+
+// Check if the heap is empty.
+bool int64RadixHeapIsEmpty(const Int64RadixHeap *h) { return h->size == 0; }
+
+// Get the size of the heap.
+size_t int64RadixHeapSize(const Int64RadixHeap *h) { return h->size; }
+
+// ---------------------------------------------------------------------------
+// Benchmark: Dijkstra on a grid graph, radix heap vs binary heap
+// ---------------------------------------------------------------------------
+
+// Binary min-heap used as the baseline
+typedef struct {
+    int64_t *data;
+    size_t size;
+} BinaryMinHeap;
+
+static void binaryPush(BinaryMinHeap *h, int64_t value) {
+    size_t i = h->size++;
+    while (i > 0 && h->data[(i - 1) / 2] > value) {
+        h->data[i] = h->data[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    h->data[i] = value;
+}
+
+static int64_t binaryPop(BinaryMinHeap *h) {
+    int64_t root = h->data[0];
+    int64_t value = h->data[--h->size];
+    size_t i = 0;
+    while (true) {
+        size_t c = 2 * i + 1;
+        if (c >= h->size)
+            break;
+        if (c + 1 < h->size && h->data[c + 1] < h->data[c])
+            c++;
+        if (h->data[c] >= value)
+            break;
+        h->data[i] = h->data[c];
+        i = c;
+    }
+    if (h->size > 0)
+        h->data[i] = value;
+    return root;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Grid graph: node (r, c) has edges to its 4 neighbours. Edge weights are
+// derived from the node id so both runs see the same graph.
+static inline int64_t edgeWeight(size_t from, size_t to) {
+    uint64_t x = (uint64_t)(from * 2654435761u) ^ (uint64_t)(to * 40503u);
+    return (int64_t)(x % 1000) + 1;
+}
+
+// Run Dijkstra with lazy deletion; the queue holds (distance << 24 | node)
+// so that a single int64_t orders by distance and carries the node id.
+static int64_t dijkstra(size_t side, bool useRadix) {
+    size_t nodes = side * side;
+    int64_t *distance = malloc(nodes * sizeof(int64_t));
+    BinaryMinHeap binary = {malloc(4 * nodes * sizeof(int64_t)), 0};
+    Int64RadixHeap *radix = int64RadixHeapCreate();
+    for (size_t v = 0; v < nodes; v++)
+        distance[v] = INT64_MAX;
+
+    distance[0] = 0;
+    if (useRadix)
+        int64RadixHeapPush(radix, 0);
+    else
+        binaryPush(&binary, 0);
+
+    while (useRadix ? !int64RadixHeapIsEmpty(radix) : binary.size > 0) {
+        int64_t entry =
+            useRadix ? int64RadixHeapPop(radix) : binaryPop(&binary);
+        size_t u = (size_t)(entry & 0xFFFFFF);
+        int64_t d = entry >> 24;
+        if (d > distance[u])
+            continue; // stale duplicate
+
+        size_t r = u / side, c = u % side;
+        size_t neighbours[4];
+        size_t count = 0;
+        if (r > 0)
+            neighbours[count++] = u - side;
+        if (r + 1 < side)
+            neighbours[count++] = u + side;
+        if (c > 0)
+            neighbours[count++] = u - 1;
+        if (c + 1 < side)
+            neighbours[count++] = u + 1;
+
+        for (size_t k = 0; k < count; k++) {
+            size_t v = neighbours[k];
+            int64_t candidate = d + edgeWeight(u, v);
+            if (candidate < distance[v]) {
+                distance[v] = candidate;
+                int64_t key = candidate << 24 | (int64_t)v;
+                if (useRadix)
+                    int64RadixHeapPush(radix, key);
+                else
+                    binaryPush(&binary, key);
+            }
+        }
+    }
+
+    int64_t checksum = 0;
+    for (size_t v = 0; v < nodes; v++)
+        checksum += distance[v];
+    free(distance);
+    free(binary.data);
+    int64RadixHeapDestroy(radix);
+    return checksum;
+}
+
+int main(void) {
+    Int64RadixHeap *h = int64RadixHeapCreate();
+    if (!h) {
+        fprintf(stderr, "Failed to create radix heap\n");
+        return EXIT_FAILURE;
+    }
+
+    // Interleave pushes and pops; pushes never go below the last pop
+    int64_t initial[] = {-40, 17, 3, 3, 250, -7, 96};
+    for (size_t i = 0; i < sizeof(initial) / sizeof(*initial); i++)
+        int64RadixHeapPush(h, initial[i]);
+    printf("Popped %ld\n", int64RadixHeapPop(h));
+    printf("Popped %ld\n", int64RadixHeapPop(h));
+    int64RadixHeapPush(h, 5);
+    if (!int64RadixHeapPush(h, -100))
+        printf("Rejected push below the last popped key\n");
+    while (!int64RadixHeapIsEmpty(h))
+        printf("Popped %ld\n", int64RadixHeapPop(h));
+    int64RadixHeapDestroy(h);
+
+    // 4M-node grid, roughly the size of a state road network
+    size_t side = 2048;
+    printf("\nDijkstra on a %zux%zu grid (%zu nodes):\n", side, side,
+           side * side);
+    double start = nowSeconds();
+    int64_t binarySum = dijkstra(side, false);
+    double middle = nowSeconds();
+    int64_t radixSum = dijkstra(side, true);
+    double end = nowSeconds();
+    printf("binary heap: %.3f s\n", middle - start);
+    printf("radix heap : %.3f s\n", end - middle);
+    printf("distances %s\n", binarySum == radixSum ? "match" : "DIFFER");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,558 @@
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Values buffered per run reader (256 KB); all disk access is in these units
+#define RUN_BUFFER_VALUES (1u << 15)
+
+// Sorted run on disk, streamed back in descending order
+typedef struct {
+    FILE *file;
+    char path[4096];
+    int64_t *buffer;
+    size_t count;     // values currently in the buffer
+    size_t pos;       // next value to hand out
+    size_t remaining; // values in the run not yet handed out
+} SpillRun;
+
+// I/O accounting
+typedef struct {
+    size_t spills;      // heap halves written out
+    size_t compactions; // merges of the smaller runs into one
+    size_t bytesWritten;
+    size_t bytesRead;
+} SpillPriorityQueueStats;
+
+// Max priority queue that keeps its hot head in a bounded in-memory heap and
+// spills the lower half of the heap to sorted run files when it fills up.
+// Runs stream back through a small heap of run heads as the head drains, so
+// disk access is purely sequential: runs are written once front to back and
+// read front to back. When the number of runs would exceed what the memory
+// cap can buffer, the smaller half of the runs is merged into one, so a value
+// is rewritten about log(runs) times rather than once per compaction.
+typedef struct {
+    int64_t *data;       // in-memory max heap
+    size_t size;         // number of elements in the heap
+    size_t heapCapacity; // spill threshold
+    SpillRun *runs;
+    size_t runCount;
+    size_t maxRuns;
+    size_t *runHeap; // max heap of run indices keyed by their head value
+    size_t total;    // elements in the heap and all runs
+    size_t nextRunId;
+    char tempDir[4000];
+    SpillPriorityQueueStats stats;
+} Int64SpillPriorityQueue;
+
+// ---------------------------------------------------------------------------
+// In-memory heap
+// ---------------------------------------------------------------------------
+
+static void heapifyUp(int64_t *data, size_t i) {
+    int64_t value = data[i];
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (data[parent] >= value)
+            break;
+        data[i] = data[parent];
+        i = parent;
+    }
+    data[i] = value;
+}
+
+static void heapifyDown(int64_t *data, size_t size, size_t i) {
+    int64_t value = data[i];
+    while (true) {
+        size_t child = 2 * i + 1;
+        if (child >= size)
+            break;
+        if (child + 1 < size && data[child + 1] > data[child])
+            child++;
+        if (data[child] <= value)
+            break;
+        data[i] = data[child];
+        i = child;
+    }
+    data[i] = value;
+}
+
+// ---------------------------------------------------------------------------
+// Runs
+// ---------------------------------------------------------------------------
+
+static inline int64_t runHead(const SpillRun *run) {
+    return run->buffer[run->pos];
+}
+
+// Load the next buffer of a run; return false on a read error
+static bool runRefill(Int64SpillPriorityQueue *pq, SpillRun *run) {
+    size_t want =
+        run->remaining < RUN_BUFFER_VALUES ? run->remaining : RUN_BUFFER_VALUES;
+    run->count = fread(run->buffer, sizeof(int64_t), want, run->file);
+    run->pos = 0;
+    pq->stats.bytesRead += run->count * sizeof(int64_t);
+    if (run->count != want) {
+        perror(run->path);
+        return false;
+    }
+    return true;
+}
+
+// Write `count` values (already in descending order) as a new run and open
+// it for streaming. Return false on I/O or allocation failure.
+static bool runCreate(Int64SpillPriorityQueue *pq, SpillRun *run,
+                      const int64_t *values, size_t count) {
+    snprintf(run->path, sizeof(run->path), "%s/int64-spill-%zu.bin",
+             pq->tempDir, pq->nextRunId++);
+    FILE *file = fopen(run->path, "wb");
+    if (!file) {
+        perror(run->path);
+        return false;
+    }
+    bool ok = fwrite(values, sizeof(int64_t), count, file) == count;
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        perror(run->path);
+        remove(run->path);
+        return false;
+    }
+    pq->stats.bytesWritten += count * sizeof(int64_t);
+
+    run->file = fopen(run->path, "rb");
+    run->buffer = malloc(RUN_BUFFER_VALUES * sizeof(int64_t));
+    run->remaining = count;
+    if (!run->file || !run->buffer || !runRefill(pq, run)) {
+        fprintf(stderr, "Failed to open run %s for reading\n", run->path);
+        if (run->file)
+            fclose(run->file);
+        free(run->buffer);
+        remove(run->path);
+        return false;
+    }
+    posix_fadvise(fileno(run->file), 0, 0, POSIX_FADV_SEQUENTIAL);
+    return true;
+}
+
+static void runClose(SpillRun *run) {
+    fclose(run->file);
+    free(run->buffer);
+    remove(run->path);
+}
+
+static inline bool runBefore(const Int64SpillPriorityQueue *pq, size_t a,
+                             size_t b) {
+    return runHead(&pq->runs[a]) > runHead(&pq->runs[b]);
+}
+
+// Heaps of run indices: pq->runHeap over all runs, or a merge heap over the
+// runs being compacted.
+static void runHeapUp(const Int64SpillPriorityQueue *pq, size_t *heap,
+                      size_t i) {
+    size_t run = heap[i];
+    while (i > 0 && runBefore(pq, run, heap[(i - 1) / 2])) {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap[i] = run;
+}
+
+static void runHeapDown(const Int64SpillPriorityQueue *pq, size_t *heap,
+                        size_t count, size_t i) {
+    size_t run = heap[i];
+    while (true) {
+        size_t c = 2 * i + 1;
+        if (c >= count)
+            break;
+        if (c + 1 < count && runBefore(pq, heap[c + 1], heap[c]))
+            c++;
+        if (!runBefore(pq, heap[c], run))
+            break;
+        heap[i] = heap[c];
+        i = c;
+    }
+    heap[i] = run;
+}
+
+// Take the head of the best run and advance it, dropping the run once empty
+static int64_t runHeapPop(Int64SpillPriorityQueue *pq) {
+    size_t index = pq->runHeap[0];
+    SpillRun *run = &pq->runs[index];
+    int64_t value = runHead(run);
+    run->remaining--;
+    if (++run->pos == run->count && run->remaining > 0 &&
+        !runRefill(pq, run)) {
+        fprintf(stderr, "Error: failed to read back spilled run\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (run->remaining > 0) {
+        runHeapDown(pq, pq->runHeap, pq->runCount, 0);
+        return value;
+    }
+
+    // Remove the exhausted run: move the last run into its slot
+    runClose(run);
+    size_t last = --pq->runCount;
+    pq->runHeap[0] = pq->runHeap[last];
+    if (last > 0)
+        runHeapDown(pq, pq->runHeap, last, 0);
+    if (index != last) {
+        pq->runs[index] = pq->runs[last];
+        for (size_t i = 0; i < pq->runCount; i++) {
+            if (pq->runHeap[i] == last)
+                pq->runHeap[i] = index;
+        }
+    }
+    return value;
+}
+
+// Rewind a run to the state it had with `remaining` values left. Runs end at
+// their last value, so the head sits `remaining` values before the end.
+static bool runRewind(Int64SpillPriorityQueue *pq, SpillRun *run,
+                      size_t remaining) {
+    run->remaining = remaining;
+    if (fseeko(run->file, -(off_t)(remaining * sizeof(int64_t)), SEEK_END)) {
+        perror(run->path);
+        return false;
+    }
+    return runRefill(pq, run);
+}
+
+// Merge the smaller half of the runs into a single new run, sequentially
+// through one buffer. The source runs are only dropped once the merged run
+// has been written and reopened; on failure they are rewound and kept.
+static bool compactRuns(Int64SpillPriorityQueue *pq) {
+    size_t n = pq->runCount, k = n / 2 < 2 ? 2 : n / 2;
+    // order[0..n): runs by size; heap[0..k): merge heap; saved: sizes
+    size_t *order = malloc((n + 2 * k) * sizeof(size_t));
+    SpillRun merged = {0};
+    snprintf(merged.path, sizeof(merged.path), "%s/int64-spill-%zu.bin",
+             pq->tempDir, pq->nextRunId++);
+    FILE *file = fopen(merged.path, "wb");
+    int64_t *out = malloc(RUN_BUFFER_VALUES * sizeof(int64_t));
+    if (!order || !file || !out) {
+        fprintf(stderr, "Failed to set up run compaction\n");
+        if (file) {
+            fclose(file);
+            remove(merged.path);
+        }
+        free(order);
+        free(out);
+        return false;
+    }
+    size_t *heap = order + n, *saved = heap + k;
+
+    for (size_t i = 0; i < n; i++) {
+        size_t j = i;
+        for (; j > 0 && pq->runs[order[j - 1]].remaining >
+                            pq->runs[i].remaining;
+             j--)
+            order[j] = order[j - 1];
+        order[j] = i;
+    }
+    for (size_t i = 0; i < k; i++) {
+        heap[i] = order[i];
+        saved[i] = pq->runs[order[i]].remaining;
+    }
+    size_t live = k;
+    for (size_t i = k / 2; i-- > 0;)
+        runHeapDown(pq, heap, live, i);
+
+    size_t count = 0, buffered = 0;
+    bool ok = true;
+    while (live > 0) {
+        SpillRun *run = &pq->runs[heap[0]];
+        out[buffered++] = runHead(run);
+        count++;
+        run->remaining--;
+        if (++run->pos == run->count && run->remaining > 0 &&
+            !runRefill(pq, run)) {
+            ok = false;
+            break;
+        }
+        if (run->remaining == 0)
+            heap[0] = heap[--live];
+        if (live > 0)
+            runHeapDown(pq, heap, live, 0);
+
+        if (buffered == RUN_BUFFER_VALUES || live == 0) {
+            if (fwrite(out, sizeof(int64_t), buffered, file) != buffered) {
+                ok = false;
+                break;
+            }
+            pq->stats.bytesWritten += buffered * sizeof(int64_t);
+            buffered = 0;
+        }
+    }
+    ok = fclose(file) == 0 && ok;
+    free(out);
+    if (ok) {
+        merged.file = fopen(merged.path, "rb");
+        merged.buffer = malloc(RUN_BUFFER_VALUES * sizeof(int64_t));
+        merged.remaining = count;
+        ok = merged.file && merged.buffer && runRefill(pq, &merged);
+    }
+
+    if (!ok) {
+        fprintf(stderr, "Failed to compact runs into %s\n", merged.path);
+        if (merged.file)
+            fclose(merged.file);
+        free(merged.buffer);
+        remove(merged.path);
+        for (size_t i = 0; i < k; i++) {
+            if (!runRewind(pq, &pq->runs[order[i]], saved[i])) {
+                fprintf(stderr, "Error: failed to rewind spilled run\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        free(order);
+        return false;
+    }
+    posix_fadvise(fileno(merged.file), 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    // Drop the merged runs, keep the rest in place and rebuild the run heap
+    for (size_t i = 0; i < k; i++) {
+        runClose(&pq->runs[order[i]]);
+        pq->runs[order[i]].file = NULL;
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (pq->runs[i].file)
+            pq->runs[kept++] = pq->runs[i];
+    }
+    pq->runs[kept++] = merged;
+    pq->runCount = kept;
+    for (size_t i = 0; i < kept; i++)
+        pq->runHeap[i] = i;
+    for (size_t i = kept / 2; i-- > 0;)
+        runHeapDown(pq, pq->runHeap, kept, i);
+    free(order);
+    pq->stats.compactions++;
+    return true;
+}
+
+// Spill the lower half of the full heap as a run. Extracting maxima from the
+// back of the array leaves it sorted ascending; the top half, reversed into
+// descending order, is itself a valid max heap. Runs are compacted first, so
+// a failure leaves `data` untouched or rebuilds it into a heap.
+static bool spill(Int64SpillPriorityQueue *pq) {
+    if (pq->runCount == pq->maxRuns && !compactRuns(pq))
+        return false;
+
+    int64_t *data = pq->data;
+    size_t n = pq->size;
+    for (size_t end = n - 1; end > 0; end--) {
+        int64_t max = data[0];
+        data[0] = data[end];
+        data[end] = max;
+        heapifyDown(data, end, 0);
+    }
+
+    size_t low = n / 2;
+    for (size_t i = 0, j = low - 1; i < j; i++, j--) {
+        int64_t t = data[i];
+        data[i] = data[j];
+        data[j] = t;
+    }
+
+    size_t index = pq->runCount;
+    if (!runCreate(pq, &pq->runs[index], data, low)) {
+        for (size_t i = n / 2; i-- > 0;)
+            heapifyDown(data, n, i);
+        return false;
+    }
+    pq->runHeap[pq->runCount++] = index;
+    runHeapUp(pq, pq->runHeap, pq->runCount - 1);
+    size_t high = n - low;
+    for (size_t i = 0; i < high; i++)
+        data[i] = data[n - 1 - i];
+    pq->size = high;
+    pq->stats.spills++;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+// Create a queue that buffers at most about `memoryCap` bytes: three quarters
+// for the heap, one quarter for run read buffers. Runs go to `tempDir`.
+Int64SpillPriorityQueue *int64SpillPriorityQueueCreate(size_t memoryCap,
+                                                       const char *tempDir) {
+    size_t runBytes = RUN_BUFFER_VALUES * sizeof(int64_t);
+    if (memoryCap < 8 * runBytes) {
+        fprintf(stderr, "Memory cap must be at least %zu bytes\n",
+                8 * runBytes);
+        return NULL;
+    }
+    Int64SpillPriorityQueue *pq = calloc(1, sizeof(*pq));
+    if (!pq) {
+        fprintf(stderr,
+                "Memory allocation failed for Int64SpillPriorityQueue\n");
+        return NULL;
+    }
+    snprintf(pq->tempDir, sizeof(pq->tempDir), "%s", tempDir);
+    pq->heapCapacity = memoryCap / 4 * 3 / sizeof(int64_t);
+    pq->maxRuns = memoryCap / 4 / runBytes;
+    pq->data = malloc(pq->heapCapacity * sizeof(int64_t));
+    pq->runs = calloc(pq->maxRuns, sizeof(SpillRun));
+    pq->runHeap = malloc(pq->maxRuns * sizeof(size_t));
+    if (!pq->data || !pq->runs || !pq->runHeap) {
+        fprintf(stderr, "Memory allocation failed for queue storage\n");
+        free(pq->data);
+        free(pq->runs);
+        free(pq->runHeap);
+        free(pq);
+        return NULL;
+    }
+    return pq;
+}
+
+// Destroy the queue, deleting any remaining run files
+void int64SpillPriorityQueueDestroy(Int64SpillPriorityQueue *pq) {
+    if (!pq)
+        return;
+    for (size_t i = 0; i < pq->runCount; i++)
+        runClose(&pq->runs[i]);
+    free(pq->data);
+    free(pq->runs);
+    free(pq->runHeap);
+    free(pq);
+}
+
+// Push a value, spilling the lower half of the heap first if it is full.
+bool int64SpillPriorityQueuePush(Int64SpillPriorityQueue *pq, int64_t value) {
+    if (pq->size == pq->heapCapacity && !spill(pq))
+        return false;
+    pq->data[pq->size] = value;
+    heapifyUp(pq->data, pq->size);
+    pq->size++;
+    pq->total++;
+    return true;
+}
+
+// Pop the maximum value, from the heap or from the best run.
+int64_t int64SpillPriorityQueuePop(Int64SpillPriorityQueue *pq) {
+    if (pq->total == 0) {
+        fprintf(stderr, "Error: pop() called on empty priority queue\n");
+        exit(EXIT_FAILURE);
+    }
+    pq->total--;
+    if (pq->runCount > 0 &&
+        (pq->size == 0 || runHead(&pq->runs[pq->runHeap[0]]) > pq->data[0]))
+        return runHeapPop(pq);
+
+    int64_t root = pq->data[0];
+    pq->size--;
+    if (pq->size > 0) {
+        pq->data[0] = pq->data[pq->size];
+        heapifyDown(pq->data, pq->size, 0);
+    }
+    return root;
+}
+
+// Peek at the maximum value without removing it.
+int64_t int64SpillPriorityQueuePeek(const Int64SpillPriorityQueue *pq) {
+    if (pq->total == 0) {
+        fprintf(stderr, "Error: peek() called on empty priority queue\n");
+        exit(EXIT_FAILURE);
+    }
+    if (pq->runCount > 0) {
+        int64_t head = runHead(&pq->runs[pq->runHeap[0]]);
+        if (pq->size == 0 || head > pq->data[0])
+            return head;
+    }
+    return pq->data[0];
+}
+
+// Check if the queue is empty.
+bool int64SpillPriorityQueueIsEmpty(const Int64SpillPriorityQueue *pq) {
+    return pq->total == 0;
+}
+
+// Get the number of values in memory and on disk.
+size_t int64SpillPriorityQueueSize(const Int64SpillPriorityQueue *pq) {
+    return pq->total;
+}
+
+// Get the I/O accounting.
+SpillPriorityQueueStats
+int64SpillPriorityQueueStats(const Int64SpillPriorityQueue *pq) {
+    return pq->stats;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(void) {
+    // Tiny cap: 2 MB buffers 196608 values in memory
+    Int64SpillPriorityQueue *pq = int64SpillPriorityQueueCreate(2u << 20, ".");
+    if (!pq) {
+        fprintf(stderr, "Failed to create priority queue\n");
+        return EXIT_FAILURE;
+    }
+    for (int64_t i = 0; i < 1000000; i++)
+        int64SpillPriorityQueuePush(pq, (i * 7919) % 1000003);
+    printf("Size %zu, peek %lld\n", int64SpillPriorityQueueSize(pq),
+           (long long)int64SpillPriorityQueuePeek(pq));
+    bool sorted = true;
+    int64_t previous = INT64_MAX;
+    while (!int64SpillPriorityQueueIsEmpty(pq)) {
+        int64_t v = int64SpillPriorityQueuePop(pq);
+        sorted &= v <= previous;
+        previous = v;
+    }
+    SpillPriorityQueueStats s = int64SpillPriorityQueueStats(pq);
+    printf("Drained in %s order after %zu spills, %zu compactions\n",
+           sorted ? "descending" : "WRONG", s.spills, s.compactions);
+    int64SpillPriorityQueueDestroy(pq);
+
+    // Sustained overflow: three pushes per pop, 24M pushes under a 32 MB cap
+    // (16M values = 128 MB queued at the peak), then a full drain
+    size_t memoryCap = 32u << 20, rounds = 8000000;
+    pq = int64SpillPriorityQueueCreate(memoryCap, ".");
+    if (!pq)
+        return EXIT_FAILURE;
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    double start = nowSeconds();
+    for (size_t r = 0; r < rounds; r++) {
+        for (int i = 0; i < 3; i++) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            if (!int64SpillPriorityQueuePush(pq, (int64_t)state))
+                return EXIT_FAILURE;
+        }
+        int64SpillPriorityQueuePop(pq);
+    }
+    double middle = nowSeconds();
+    size_t peak = int64SpillPriorityQueueSize(pq);
+    sorted = true;
+    previous = INT64_MAX;
+    while (!int64SpillPriorityQueueIsEmpty(pq)) {
+        int64_t v = int64SpillPriorityQueuePop(pq);
+        sorted &= v <= previous;
+        previous = v;
+    }
+    double end = nowSeconds();
+
+    s = int64SpillPriorityQueueStats(pq);
+    printf("\n%zu MB cap, %zu values queued at peak (%zu MB):\n",
+           memoryCap >> 20, peak, peak * sizeof(int64_t) >> 20);
+    printf("overflow phase: %.2f Mops/s (%.2f s)\n",
+           (double)(4 * rounds) / (middle - start) / 1e6, middle - start);
+    printf("drain phase   : %.2f Mops/s (%.2f s), %s\n",
+           (double)peak / (end - middle) / 1e6, end - middle,
+           sorted ? "descending" : "WRONG ORDER");
+    printf("spills %zu, compactions %zu, written %zu MB, read %zu MB\n",
+           s.spills, s.compactions, s.bytesWritten >> 20, s.bytesRead >> 20);
+    int64SpillPriorityQueueDestroy(pq);
+    return EXIT_SUCCESS;
+}
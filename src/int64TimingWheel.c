@@ -0,0 +1,564 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Wheel geometry: 4 levels of 256 slots cover 2^32 ticks ahead of `now`.
+// Timers further out than that wait in an overflow heap.
+#define WHEEL_LEVELS 4
+#define WHEEL_SLOT_BITS 8
+#define WHEEL_SLOTS (1u << WHEEL_SLOT_BITS)
+#define WHEEL_SLOT_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_SPAN_BITS (WHEEL_LEVELS * WHEEL_SLOT_BITS)
+
+// End of a slot list / free list
+#define TIMER_NIL UINT32_MAX
+
+typedef enum {
+    TIMER_FREE,
+    TIMER_WHEEL,     // linked into a wheel slot
+    TIMER_OVERFLOW,  // waiting in the overflow heap
+    TIMER_EXPIRING,  // in the batch of the tick being expired
+    TIMER_FIRING,    // its callback is running
+    TIMER_CANCELLED, // cancelled in the overflow heap or an expiring batch
+} TimerState;
+
+// A timer node. Nodes live in a pool and are linked into slot lists by index,
+// so scheduling and cancelling never allocate once the pool is warm.
+typedef struct {
+    int64_t expiry;      // tick at which the timer fires
+    int64_t payload;     // caller data handed to the callback
+    uint32_t prev, next; // slot list links (next doubles as free list link)
+    uint32_t generation; // bumped on reuse so stale handles are rejected
+    uint32_t state;      // TimerState
+    uint32_t location;   // level * WHEEL_SLOTS + slot while on the wheel
+} TimerNode;
+
+// Called for every expired timer
+typedef void (*TimerCallback)(uint64_t handle, int64_t payload,
+                              void *context);
+
+// Hierarchical timing wheel.
+// A timer sits on the lowest level whose slot digit is the first one (from
+// the top) where its expiry differs from the current tick. When the current
+// tick enters a slot of a higher level, that slot is cascaded: its timers are
+// re-placed on lower levels. schedule and cancel are O(1).
+typedef struct {
+    TimerNode *nodes; // node pool
+    size_t nodeCapacity;
+    size_t nodeCount;  // nodes ever handed out (pool high-water mark)
+    uint32_t freeList; // recycled nodes
+    uint32_t slots[WHEEL_LEVELS][WHEEL_SLOTS]; // slot list heads
+    size_t levelCount[WHEEL_LEVELS];           // timers on each level
+    uint32_t *overflow; // min-heap of node indices ordered by expiry
+    size_t overflowSize;
+    size_t overflowCapacity;
+    int64_t now;    // last processed tick
+    size_t pending; // scheduled and not yet expired or cancelled
+} Int64TimingWheel;
+
+// Handles pack the node index with its generation
+static inline uint64_t makeHandle(uint32_t index, uint32_t generation) {
+    return (uint64_t)generation << 32 | index;
+}
+
+// Resolve a handle to its node, or NULL if it is stale or invalid
+static TimerNode *resolveHandle(Int64TimingWheel *w, uint64_t handle) {
+    uint32_t index = (uint32_t)handle;
+    if (index >= w->nodeCount)
+        return NULL;
+    TimerNode *node = &w->nodes[index];
+    if (node->generation != (uint32_t)(handle >> 32))
+        return NULL;
+    return node;
+}
+
+// Take a node from the free list or the end of the pool
+static uint32_t allocateNode(Int64TimingWheel *w) {
+    if (w->freeList != TIMER_NIL) {
+        uint32_t index = w->freeList;
+        w->freeList = w->nodes[index].next;
+        return index;
+    }
+    if (w->nodeCount == w->nodeCapacity) {
+        size_t newCapacity = w->nodeCapacity * 2;
+        if (newCapacity >= TIMER_NIL) {
+            fprintf(stderr, "Timer pool cannot exceed %u nodes\n", TIMER_NIL);
+            return TIMER_NIL;
+        }
+        TimerNode *newNodes =
+            realloc(w->nodes, newCapacity * sizeof(TimerNode));
+        if (!newNodes) {
+            fprintf(stderr, "Memory (re)allocation failed for capacity %zu\n",
+                    newCapacity);
+            return TIMER_NIL;
+        }
+        w->nodes = newNodes;
+        w->nodeCapacity = newCapacity;
+    }
+    w->nodes[w->nodeCount].generation = 1; // handle 0 is never valid
+    return (uint32_t)w->nodeCount++;
+}
+
+// Return a node to the free list, invalidating outstanding handles
+static void releaseNode(Int64TimingWheel *w, uint32_t index) {
+    TimerNode *node = &w->nodes[index];
+    node->state = TIMER_FREE;
+    node->generation++;
+    node->next = w->freeList;
+    w->freeList = index;
+}
+
+// Push a node index onto a slot list
+static void slotPush(Int64TimingWheel *w, size_t level, size_t slot,
+                     uint32_t index) {
+    TimerNode *node = &w->nodes[index];
+    uint32_t *head = &w->slots[level][slot];
+    node->prev = TIMER_NIL;
+    node->next = *head;
+    node->location = (uint32_t)(level * WHEEL_SLOTS + slot);
+    if (*head != TIMER_NIL)
+        w->nodes[*head].prev = index;
+    *head = index;
+    w->levelCount[level]++;
+}
+
+// Unlink a node from the slot list that holds it
+static void slotUnlink(Int64TimingWheel *w, uint32_t index) {
+    TimerNode *node = &w->nodes[index];
+    size_t level = node->location / WHEEL_SLOTS;
+    if (node->prev != TIMER_NIL)
+        w->nodes[node->prev].next = node->next;
+    else
+        w->slots[level][node->location % WHEEL_SLOTS] = node->next;
+    if (node->next != TIMER_NIL)
+        w->nodes[node->next].prev = node->prev;
+    w->levelCount[level]--;
+}
+
+// Overflow heap helpers (min-heap on expiry)
+static inline bool overflowBefore(const Int64TimingWheel *w, uint32_t a,
+                                  uint32_t b) {
+    return w->nodes[a].expiry < w->nodes[b].expiry;
+}
+
+static bool overflowPush(Int64TimingWheel *w, uint32_t index) {
+    if (w->overflowSize == w->overflowCapacity) {
+        size_t newCapacity = w->overflowCapacity ? w->overflowCapacity * 2 : 64;
+        uint32_t *newHeap =
+            realloc(w->overflow, newCapacity * sizeof(uint32_t));
+        if (!newHeap) {
+            fprintf(stderr, "Memory (re)allocation failed for capacity %zu\n",
+                    newCapacity);
+            return false;
+        }
+        w->overflow = newHeap;
+        w->overflowCapacity = newCapacity;
+    }
+    size_t i = w->overflowSize++;
+    while (i > 0 && overflowBefore(w, index, w->overflow[(i - 1) / 2])) {
+        w->overflow[i] = w->overflow[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    w->overflow[i] = index;
+    return true;
+}
+
+static uint32_t overflowPop(Int64TimingWheel *w) {
+    uint32_t root = w->overflow[0];
+    uint32_t last = w->overflow[--w->overflowSize];
+    size_t i = 0;
+    while (true) {
+        size_t c = 2 * i + 1;
+        if (c >= w->overflowSize)
+            break;
+        if (c + 1 < w->overflowSize &&
+            overflowBefore(w, w->overflow[c + 1], w->overflow[c]))
+            c++;
+        if (!overflowBefore(w, w->overflow[c], last))
+            break;
+        w->overflow[i] = w->overflow[c];
+        i = c;
+    }
+    if (w->overflowSize > 0)
+        w->overflow[i] = last;
+    return root;
+}
+
+// Place a node on the wheel relative to the current tick, or in the overflow
+// heap if it is beyond the wheel span.
+static bool placeNode(Int64TimingWheel *w, uint32_t index) {
+    TimerNode *node = &w->nodes[index];
+    int64_t diff = node->expiry ^ w->now;
+    if ((diff >> WHEEL_SPAN_BITS) != 0) {
+        node->state = TIMER_OVERFLOW;
+        return overflowPush(w, index);
+    }
+
+    size_t level = 0;
+    while (level + 1 < WHEEL_LEVELS &&
+           (diff >> ((level + 1) * WHEEL_SLOT_BITS)) != 0)
+        level++;
+    size_t slot =
+        (size_t)(node->expiry >> (level * WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK;
+    node->state = TIMER_WHEEL;
+    slotPush(w, level, slot, index);
+    return true;
+}
+
+// Create a new timing wheel starting at tick `now`.
+Int64TimingWheel *int64TimingWheelCreate(int64_t now, size_t initialCapacity) {
+    if (initialCapacity == 0) {
+        fprintf(stderr, "Initial capacity must be > 0 (got %zu)\n",
+                initialCapacity);
+        return NULL;
+    }
+
+    Int64TimingWheel *w = calloc(1, sizeof(*w));
+    if (!w) {
+        fprintf(stderr, "Memory allocation failed for Int64TimingWheel\n");
+        return NULL;
+    }
+    w->nodes = malloc(initialCapacity * sizeof(TimerNode));
+    if (!w->nodes) {
+        fprintf(stderr, "Memory allocation failed for timer pool\n");
+        free(w);
+        return NULL;
+    }
+    w->nodeCapacity = initialCapacity;
+    w->freeList = TIMER_NIL;
+    for (size_t level = 0; level < WHEEL_LEVELS; level++)
+        for (size_t slot = 0; slot < WHEEL_SLOTS; slot++)
+            w->slots[level][slot] = TIMER_NIL;
+    w->now = now;
+    return w;
+}
+
+// Destroy the timing wheel memory
+void int64TimingWheelDestroy(Int64TimingWheel *w) {
+    if (!w)
+        return;
+    free(w->nodes);
+    free(w->overflow);
+    free(w);
+}
+
+// Schedule a timer firing at tick `expiry` (ticks in the past fire on the
+// next advance). Returns a handle for cancellation, or 0 on failure.
+uint64_t int64TimingWheelSchedule(Int64TimingWheel *w, int64_t expiry,
+                                  int64_t payload) {
+    uint32_t index = allocateNode(w);
+    if (index == TIMER_NIL)
+        return 0;
+
+    TimerNode *node = &w->nodes[index];
+    node->expiry = expiry > w->now ? expiry : w->now + 1;
+    node->payload = payload;
+    if (!placeNode(w, index)) {
+        releaseNode(w, index);
+        return 0;
+    }
+    w->pending++;
+    return makeHandle(index, node->generation);
+}
+
+// Cancel a pending timer in O(1).
+// Return false if the handle is stale (already fired or cancelled).
+bool int64TimingWheelCancel(Int64TimingWheel *w, uint64_t handle) {
+    TimerNode *node = resolveHandle(w, handle);
+    if (!node)
+        return false;
+
+    uint32_t index = (uint32_t)handle;
+    if (node->state == TIMER_WHEEL) {
+        slotUnlink(w, index);
+        releaseNode(w, index);
+    } else if (node->state == TIMER_OVERFLOW ||
+               node->state == TIMER_EXPIRING) {
+        // Removed lazily when it reaches the top of the overflow heap, or
+        // skipped when the expiring batch reaches it
+        node->state = TIMER_CANCELLED;
+    } else {
+        return false;
+    }
+    w->pending--;
+    return true;
+}
+
+// Re-place every timer of a higher-level slot relative to the current tick
+static void cascadeSlot(Int64TimingWheel *w, size_t level, size_t slot) {
+    uint32_t index = w->slots[level][slot];
+    w->slots[level][slot] = TIMER_NIL;
+    while (index != TIMER_NIL) {
+        uint32_t next = w->nodes[index].next;
+        w->levelCount[level]--;
+        placeNode(w, index); // always lands on a lower level, never fails
+        index = next;
+    }
+}
+
+// Move overflow timers that now fall inside the wheel span onto the wheel
+static void drainOverflow(Int64TimingWheel *w) {
+    while (w->overflowSize > 0) {
+        uint32_t top = w->overflow[0];
+        TimerNode *node = &w->nodes[top];
+        if (node->state == TIMER_CANCELLED) {
+            overflowPop(w);
+            releaseNode(w, top);
+            continue;
+        }
+        if (((node->expiry ^ w->now) >> WHEEL_SPAN_BITS) != 0)
+            break;
+        overflowPop(w);
+        placeNode(w, top);
+    }
+}
+
+// Advance the wheel to tick `now`, calling `callback` for every timer that
+// expires on the way, in tick order. Timers of one slot are detached before
+// their callbacks run, so callbacks may schedule or cancel other timers.
+// Returns the number of expired timers.
+size_t int64TimingWheelAdvance(Int64TimingWheel *w, int64_t now,
+                               TimerCallback callback, void *context) {
+    size_t expired = 0;
+    while (w->now < now) {
+        if (w->pending == 0) {
+            // Nothing can fire; jump straight to the target tick
+            w->now = now;
+            drainOverflow(w);
+            break;
+        }
+
+        // Skip ticks that cannot fire anything: if levels 0..L are empty,
+        // nothing happens before the next cascade of level L + 1
+        size_t emptyLevels = 0;
+        while (emptyLevels < WHEEL_LEVELS && w->levelCount[emptyLevels] == 0)
+            emptyLevels++;
+        if (emptyLevels > 0) {
+            int64_t step = (int64_t)1 << (emptyLevels * WHEEL_SLOT_BITS);
+            int64_t lastQuiet = (w->now | (step - 1));
+            if (lastQuiet > w->now) {
+                w->now = lastQuiet < now ? lastQuiet : now;
+                continue;
+            }
+        }
+
+        w->now++;
+        int64_t tick = w->now;
+
+        // Crossing into a new span: pull far-future timers in first
+        if ((tick & (((int64_t)1 << WHEEL_SPAN_BITS) - 1)) == 0)
+            drainOverflow(w);
+
+        // Cascade from the highest level whose lower digits are all zero
+        size_t top = 0;
+        while (top + 1 < WHEEL_LEVELS &&
+               (tick & (((int64_t)1 << ((top + 1) * WHEEL_SLOT_BITS)) - 1)) ==
+                   0)
+            top++;
+        for (size_t level = top; level >= 1; level--)
+            cascadeSlot(w, level,
+                        (size_t)(tick >> (level * WHEEL_SLOT_BITS)) &
+                            WHEEL_SLOT_MASK);
+
+        // Expire the level 0 slot as one batch. The whole batch is marked
+        // expiring first, so a callback cancelling a timer due on this tick
+        // only flags it; every node is released once, after its callback.
+        uint32_t *head = &w->slots[0][tick & WHEEL_SLOT_MASK];
+        uint32_t batch = *head;
+        *head = TIMER_NIL;
+        for (uint32_t i = batch; i != TIMER_NIL; i = w->nodes[i].next) {
+            w->nodes[i].state = TIMER_EXPIRING;
+            w->levelCount[0]--;
+        }
+        uint32_t index = batch;
+        while (index != TIMER_NIL) {
+            // Callbacks may schedule and grow the pool: index, not pointer
+            uint32_t next = w->nodes[index].next;
+            if (w->nodes[index].state == TIMER_EXPIRING) {
+                w->nodes[index].state = TIMER_FIRING;
+                w->pending--;
+                expired++;
+                if (callback)
+                    callback(makeHandle(index, w->nodes[index].generation),
+                             w->nodes[index].payload, context);
+            }
+            releaseNode(w, index);
+            index = next;
+        }
+    }
+    return expired;
+}
+
+// Number of scheduled timers that have neither fired nor been cancelled.
+size_t int64TimingWheelPending(const Int64TimingWheel *w) {
+    return w->pending;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: 10M timers, 95% cancelled before they fire
+// ---------------------------------------------------------------------------
+
+static void printTimer(uint64_t handle, int64_t payload, void *context) {
+    (void)handle;
+    printf("  tick %ld: timer '%s' fired\n", *(int64_t *)context,
+           (const char *)(intptr_t)payload);
+}
+
+static void countTimer(uint64_t handle, int64_t payload, void *context) {
+    (void)handle;
+    *(int64_t *)context += payload;
+}
+
+// A callback that cancels another timer due on the same tick
+typedef struct {
+    Int64TimingWheel *wheel;
+    uint64_t victim;
+} CancelContext;
+
+static void cancelSibling(uint64_t handle, int64_t payload, void *context) {
+    (void)handle;
+    CancelContext *c = context;
+    printf("  timer %c fired", (char)payload);
+    if (payload == 'A')
+        printf(", cancelling B: %s",
+               int64TimingWheelCancel(c->wheel, c->victim) ? "ok" : "failed");
+    printf("\n");
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Binary min-heap of expiries with a cancelled flag per timer, i.e. the
+// priority queue approach the wheel replaces
+typedef struct {
+    int64_t *expiry; // per timer
+    uint32_t *heap;  // timer ids ordered by expiry
+    bool *cancelled;
+    size_t size;
+} HeapTimers;
+
+static void heapTimersPush(HeapTimers *h, uint32_t id) {
+    size_t i = h->size++;
+    while (i > 0 && h->expiry[h->heap[(i - 1) / 2]] > h->expiry[id]) {
+        h->heap[i] = h->heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    h->heap[i] = id;
+}
+
+static uint32_t heapTimersPop(HeapTimers *h) {
+    uint32_t root = h->heap[0];
+    uint32_t last = h->heap[--h->size];
+    size_t i = 0;
+    while (true) {
+        size_t c = 2 * i + 1;
+        if (c >= h->size)
+            break;
+        if (c + 1 < h->size &&
+            h->expiry[h->heap[c + 1]] < h->expiry[h->heap[c]])
+            c++;
+        if (h->expiry[h->heap[c]] >= h->expiry[last])
+            break;
+        h->heap[i] = h->heap[c];
+        i = c;
+    }
+    if (h->size > 0)
+        h->heap[i] = last;
+    return root;
+}
+
+int main(void) {
+    int64_t tick = 0;
+    Int64TimingWheel *w = int64TimingWheelCreate(tick, 16);
+    if (!w) {
+        fprintf(stderr, "Failed to create timing wheel\n");
+        return EXIT_FAILURE;
+    }
+
+    int64TimingWheelSchedule(w, 5, (int64_t)(intptr_t) "retry");
+    uint64_t idle =
+        int64TimingWheelSchedule(w, 300, (int64_t)(intptr_t) "idle");
+    int64TimingWheelSchedule(w, 70000, (int64_t)(intptr_t) "keepalive");
+    int64TimingWheelSchedule(w, (int64_t)1 << 33,
+                             (int64_t)(intptr_t) "lease (overflow heap)");
+    int64TimingWheelCancel(w, idle);
+
+    // Advance in steps so the callback can print the tick
+    int64_t steps[] = {1, 5, 299, 300, 70000, (int64_t)1 << 33};
+    for (size_t i = 0; i < sizeof(steps) / sizeof(*steps); i++) {
+        tick = steps[i];
+        int64TimingWheelAdvance(w, tick, printTimer, &tick);
+    }
+    printf("Pending after demo: %zu\n", int64TimingWheelPending(w));
+
+    // Three timers on one tick; A's callback cancels B, so B never fires
+    CancelContext sibling = {w, 0};
+    int64_t base = w->now;
+    int64TimingWheelSchedule(w, base + 10, 'C');
+    sibling.victim = int64TimingWheelSchedule(w, base + 10, 'B');
+    int64TimingWheelSchedule(w, base + 10, 'A');
+    size_t fired = int64TimingWheelAdvance(w, base + 10, cancelSibling,
+                                           &sibling);
+    printf("Same-tick cancel: %zu fired, %zu pending\n", fired,
+           int64TimingWheelPending(w));
+    int64TimingWheelDestroy(w);
+
+    // Timeouts spread over 2^20 ticks, 95% cancelled before expiry
+    size_t n = 10000000;
+    int64_t horizon = 1 << 20;
+    int64_t *expiry = malloc(n * sizeof(int64_t));
+    uint64_t *handles = malloc(n * sizeof(uint64_t));
+    bool *cancel = malloc(n * sizeof(bool));
+    if (!expiry || !handles || !cancel)
+        return EXIT_FAILURE;
+    uint64_t state = 88172645463325252ULL;
+    int64_t expectedSum = 0;
+    for (size_t i = 0; i < n; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        expiry[i] = 1 + (int64_t)(state % (uint64_t)horizon);
+        cancel[i] = (state >> 32) % 100 < 95;
+        if (!cancel[i])
+            expectedSum += (int64_t)i;
+    }
+    printf("\n%zu timers over %ld ticks, 95%% cancelled:\n", n, horizon);
+
+    double start = nowSeconds();
+    w = int64TimingWheelCreate(0, n);
+    for (size_t i = 0; i < n; i++)
+        handles[i] = int64TimingWheelSchedule(w, expiry[i], (int64_t)i);
+    for (size_t i = 0; i < n; i++)
+        if (cancel[i])
+            int64TimingWheelCancel(w, handles[i]);
+    int64_t wheelSum = 0;
+    int64TimingWheelAdvance(w, horizon, countTimer, &wheelSum);
+    int64TimingWheelDestroy(w);
+    double middle = nowSeconds();
+
+    HeapTimers h = {expiry, malloc(n * sizeof(uint32_t)), cancel, 0};
+    for (size_t i = 0; i < n; i++)
+        heapTimersPush(&h, (uint32_t)i);
+    int64_t heapSum = 0;
+    while (h.size > 0) {
+        uint32_t id = heapTimersPop(&h);
+        if (!h.cancelled[id])
+            heapSum += (int64_t)id;
+    }
+    free(h.heap);
+    double end = nowSeconds();
+
+    printf("timing wheel: %.3f s\n", middle - start);
+    printf("binary heap : %.3f s\n", end - middle);
+    bool match = wheelSum == expectedSum && heapSum == expectedSum;
+    printf("fired timers %s\n", match ? "match" : "DIFFER");
+    free(expiry);
+    free(handles);
+    free(cancel);
+    return EXIT_SUCCESS;
+}
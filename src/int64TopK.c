@@ -0,0 +1,289 @@
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_KERNELS 1
+#endif
+
+// Streaming top-K selector.
+// Keeps the K largest values seen so far in a bounded min-heap: the root is
+// the smallest kept value, i.e. the threshold a new value has to beat. Once
+// the heap is full almost every input is rejected by that single compare.
+typedef struct {
+    int64_t *data; // min-heap of the kept values
+    size_t size;   // number of kept values (<= k)
+    size_t k;      // number of values to keep
+} Int64TopK;
+
+// Helper function to compute parent/child indices
+static inline size_t heapParent(size_t index) { return (index - 1) / 2; }
+static inline size_t heapLeftChild(size_t index) { return 2 * index + 1; }
+
+// Create a new top-K selector
+Int64TopK *int64TopKCreate(size_t k) {
+    if (k == 0) {
+        fprintf(stderr, "K must be greater than 0\n");
+        return NULL;
+    }
+    Int64TopK *t = calloc(1, sizeof(Int64TopK));
+    if (!t || !(t->data = calloc(k, sizeof(int64_t)))) {
+        fprintf(stderr, "Failed to create Int64TopK\n");
+        free(t);
+        return NULL;
+    }
+    t->k = k;
+    return t;
+}
+
+// Free the top-K selector memory
+void int64TopKDestroy(Int64TopK *t) {
+    if (t) {
+        free(t->data);
+        free(t);
+    }
+}
+
+// Restore the min-heap property moving the value at index i down
+static void heapifyDown(Int64TopK *t, size_t i) {
+    int64_t value = t->data[i];
+    while (true) {
+        size_t child = heapLeftChild(i);
+        if (child >= t->size)
+            break;
+        if (child + 1 < t->size && t->data[child + 1] < t->data[child])
+            child++;
+        if (t->data[child] >= value)
+            break;
+        t->data[i] = t->data[child];
+        i = child;
+    }
+    t->data[i] = value;
+}
+
+// Restore the min-heap property moving the value at index i up
+static void heapifyUp(Int64TopK *t, size_t i) {
+    int64_t value = t->data[i];
+    while (i > 0 && t->data[heapParent(i)] > value) {
+        t->data[i] = t->data[heapParent(i)];
+        i = heapParent(i);
+    }
+    t->data[i] = value;
+}
+
+// Offer a value that is known to beat the threshold of a full heap
+static inline void replaceMin(Int64TopK *t, int64_t value) {
+    t->data[0] = value;
+    heapifyDown(t, 0);
+}
+
+// Offer one value to the selector.
+void int64TopKOffer(Int64TopK *t, int64_t value) {
+    if (t->size < t->k) {
+        t->data[t->size] = value;
+        heapifyUp(t, t->size);
+        t->size++;
+    } else if (value > t->data[0]) {
+        replaceMin(t, value);
+    }
+}
+
+#ifdef HAVE_X86_KERNELS
+// Prefilter of int64TopKOfferBlock for a full heap: values are compared
+// against the threshold 16 at a time and only groups with a value that beats
+// it touch the heap. Returns the index of the first value not yet offered.
+__attribute__((target("avx2"))) static size_t
+offerBlockAvx2(Int64TopK *t, const int64_t *values, size_t i, size_t count) {
+    __m256i threshold = _mm256_set1_epi64x(t->data[0]);
+    for (; i + 16 <= count; i += 16) {
+        // Test 16 values per iteration so the common case is one branch
+        __m256i a = _mm256_loadu_si256((const __m256i *)(values + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(values + i + 4));
+        __m256i c = _mm256_loadu_si256((const __m256i *)(values + i + 8));
+        __m256i d = _mm256_loadu_si256((const __m256i *)(values + i + 12));
+        __m256i any = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpgt_epi64(a, threshold),
+                            _mm256_cmpgt_epi64(b, threshold)),
+            _mm256_or_si256(_mm256_cmpgt_epi64(c, threshold),
+                            _mm256_cmpgt_epi64(d, threshold)));
+        if (_mm256_testz_si256(any, any))
+            continue;
+
+        for (size_t j = i; j < i + 16; j++) {
+            if (values[j] > t->data[0])
+                replaceMin(t, values[j]);
+        }
+        // Accepted values can only raise the threshold
+        threshold = _mm256_set1_epi64x(t->data[0]);
+    }
+    return i;
+}
+#endif
+
+// Set before main() runs when the CPU supports AVX2
+static bool useAvx2Prefilter = false;
+
+__attribute__((constructor)) static void selectPrefilter(void) {
+#ifdef HAVE_X86_KERNELS
+    __builtin_cpu_init();
+    useAvx2Prefilter = __builtin_cpu_supports("avx2");
+#endif
+}
+
+// Offer a block of values to the selector.
+// Once the heap is full, values go through the AVX2 prefilter when the CPU
+// has it, and only groups with a value that beats the threshold touch the
+// heap. The remainder is offered one at a time.
+void int64TopKOfferBlock(Int64TopK *t, const int64_t *values, size_t count) {
+    size_t i = 0;
+    // Fill phase: everything is accepted until K values are kept
+    for (; i < count && t->size < t->k; i++)
+        int64TopKOffer(t, values[i]);
+
+#ifdef HAVE_X86_KERNELS
+    if (useAvx2Prefilter && t->size > 0)
+        i = offerBlockAvx2(t, values, i, count);
+#endif
+
+    int64_t min = t->size > 0 ? t->data[0] : INT64_MIN;
+    for (; i < count; i++) {
+        if (values[i] > min) {
+            replaceMin(t, values[i]);
+            min = t->data[0];
+        }
+    }
+}
+
+// Merge the values kept by `src` into `dst` (both must use the same K).
+void int64TopKMerge(Int64TopK *dst, const Int64TopK *src) {
+    int64TopKOfferBlock(dst, src->data, src->size);
+}
+
+// Copy the kept values to `out` in descending order and return their count.
+// `out` must have room for K values; the selector is left unchanged.
+size_t int64TopKResult(const Int64TopK *t, int64_t *out) {
+    Int64TopK copy = {out, t->size, t->k};
+    memcpy(out, t->data, t->size * sizeof(int64_t));
+
+    // In-place heap sort on the copy: popping the min to the back of the
+    // array leaves it sorted in descending order
+    while (copy.size > 1) {
+        int64_t min = copy.data[0];
+        copy.size--;
+        copy.data[0] = copy.data[copy.size];
+        heapifyDown(&copy, 0);
+        copy.data[copy.size] = min;
+    }
+    return t->size;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: top-K of a large array, single and multi-threaded
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    const int64_t *values;
+    size_t count;
+    Int64TopK *topK;
+} TopKWorker;
+
+static void *topKWorkerRun(void *arg) {
+    TopKWorker *w = arg;
+    int64TopKOfferBlock(w->topK, w->values, w->count);
+    return NULL;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Select the top K with `threads` per-thread selectors merged at the end
+static double benchmarkTopK(const int64_t *values, size_t n, size_t k,
+                            size_t threads, int64_t *out) {
+    pthread_t tids[16];
+    TopKWorker workers[16];
+    double start = nowSeconds();
+    for (size_t i = 0; i < threads; i++) {
+        size_t begin = n / threads * i;
+        size_t end = i + 1 == threads ? n : n / threads * (i + 1);
+        workers[i] = (TopKWorker){values + begin, end - begin,
+                                  int64TopKCreate(k)};
+        pthread_create(&tids[i], NULL, topKWorkerRun, &workers[i]);
+    }
+    for (size_t i = 0; i < threads; i++)
+        pthread_join(tids[i], NULL);
+    for (size_t i = 1; i < threads; i++) {
+        int64TopKMerge(workers[0].topK, workers[i].topK);
+        int64TopKDestroy(workers[i].topK);
+    }
+    int64TopKResult(workers[0].topK, out);
+    int64TopKDestroy(workers[0].topK);
+    return nowSeconds() - start;
+}
+
+int main(void) {
+    Int64TopK *t = int64TopKCreate(5);
+    if (!t)
+        return EXIT_FAILURE;
+
+    int64_t sample[] = {12, -3, 45, 7, 99, 23, 0, 64, 8, 31, -50, 77, 5};
+    int64TopKOfferBlock(t, sample, sizeof(sample) / sizeof(*sample));
+    int64_t top[5];
+    size_t count = int64TopKResult(t, top);
+    printf("Top %zu values:", count);
+    for (size_t i = 0; i < count; i++)
+        printf(" %lld", (long long)top[i]);
+    printf("\n");
+    int64TopKDestroy(t);
+
+    // Random input; the top-K must match across thread counts
+    size_t n = 32 * 1024 * 1024, k = 100;
+    int64_t *values = malloc(n * sizeof(int64_t));
+    int64_t *copy = malloc(n * sizeof(int64_t));
+    int64_t *result = malloc(k * sizeof(int64_t));
+    int64_t *reference = malloc(k * sizeof(int64_t));
+    if (!values || !copy || !result || !reference)
+        return EXIT_FAILURE;
+    uint64_t state = 88172645463325252ULL;
+    for (size_t i = 0; i < n; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        values[i] = (int64_t)state;
+    }
+
+    // Baseline: a plain copy of the same buffer (destination pre-faulted)
+    volatile int64_t *touch = copy;
+    for (size_t i = 0; i < n; i += 512)
+        touch[i] = 0;
+    double start = nowSeconds();
+    memcpy(copy, values, n * sizeof(int64_t));
+    double memcpySeconds = nowSeconds() - start;
+    double gigabytes = (double)(n * sizeof(int64_t)) / 1e9;
+    printf("\nmemcpy of %zu values: %.2f GB/s (last %lld)\n", n,
+           gigabytes / memcpySeconds, (long long)copy[n - 1]);
+
+    benchmarkTopK(values, n, k, 1, reference);
+    size_t threadCounts[] = {1, 2, 4, 8};
+    for (size_t i = 0; i < sizeof(threadCounts) / sizeof(*threadCounts); i++) {
+        double seconds =
+            benchmarkTopK(values, n, k, threadCounts[i], result);
+        printf("top-%zu, %zu thread(s): %.2f GB/s%s\n", k, threadCounts[i],
+               gigabytes / seconds,
+               memcmp(result, reference, k * sizeof(int64_t)) ? "  MISMATCH"
+                                                               : "");
+    }
+
+    free(values);
+    free(copy);
+    free(result);
+    free(reference);
+    return EXIT_SUCCESS;
+}
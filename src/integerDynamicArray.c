@@ -1,63 +1,459 @@
+#define _GNU_SOURCE
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_KERNELS 1
+#endif
 
 // Structure to hold the dynamic integer array
 typedef struct {
-    int *data;       // Pointer to the array holding the data
-    size_t size;     // Current number of elements in the array
-    size_t capacity; // Current capacity of the array (adjustable)
+    int *data;           // Pointer to the array holding the data
+    size_t size;         // Current number of elements in the array
+    size_t capacity;     // Current capacity of the array (adjustable)
+    double growthFactor; // Capacity multiplier applied when the array is full
+    bool mapped;         // data is an mmap() mapping, not malloc() memory
 } IntegerDynamicArray;
 
+// Buffers from this size up live in their own anonymous mapping: growing
+// them with mremap() moves page table entries instead of copying data, and
+// never needs the old and new buffer at once
+#define MAPPED_THRESHOLD_BYTES (64u << 20)
+#define DEFAULT_GROWTH_FACTOR 2.0
+
+// Round a byte count up to whole pages
+static size_t pageAlign(size_t bytes) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    return (bytes + page - 1) / page * page;
+}
+
+// Move the array to a buffer of exactly newCapacity elements (rounded up to
+// whole pages for mappings). Keeps the first `size` elements.
+static bool resizeIntegerDynamicArray(IntegerDynamicArray *array,
+                                      size_t newCapacity) {
+    size_t bytes = newCapacity * sizeof(int);
+    if (array->mapped || bytes >= MAPPED_THRESHOLD_BYTES) {
+        bytes = pageAlign(bytes > 0 ? bytes : 1);
+        void *p;
+        if (array->mapped) {
+            p = mremap(array->data, array->capacity * sizeof(int), bytes,
+                       MREMAP_MAYMOVE);
+        } else {
+            p = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        }
+        if (p == MAP_FAILED) {
+            perror("Mapping the array buffer failed");
+            return false;
+        }
+        // Transparent huge pages cut TLB misses on scans of large arrays
+        madvise(p, bytes, MADV_HUGEPAGE);
+        if (!array->mapped) {
+            // One last copy out of the heap
+            if (array->size > 0)
+                memcpy(p, array->data, array->size * sizeof(int));
+            free(array->data);
+            array->mapped = true;
+        }
+        array->data = p;
+        array->capacity = bytes / sizeof(int);
+        return true;
+    }
+
+    int *newData = (int *)realloc(array->data, bytes > 0 ? bytes : 1);
+    if (newData == NULL) {
+        fprintf(stderr, "Memory allocation failed for capacity %zu\n",
+                newCapacity);
+        return false;
+    }
+    array->data = newData;
+    array->capacity = newCapacity;
+    return true;
+}
+
 // Initialize the dynamic integer array with the given initial capacity
 bool initializeIntegerDynamicArray(IntegerDynamicArray *array,
                                    size_t initialCapacity) {
+    array->data = NULL;
+    array->size = 0;
+    array->capacity = 0;
+    array->growthFactor = DEFAULT_GROWTH_FACTOR;
+    array->mapped = false;
+    if (initialCapacity * sizeof(int) >= MAPPED_THRESHOLD_BYTES)
+        return resizeIntegerDynamicArray(array, initialCapacity);
+
     array->data = (int *)calloc(initialCapacity, sizeof(int));
     if (array->data == NULL) {
         fprintf(stderr, "Memory allocation failed during initialization\n");
         return false;
     }
-    array->size = 0;
     array->capacity = initialCapacity;
     return true;
 }
 
 // Free memory allocated for the dynamic integer array
 void freeIntegerDynamicArray(IntegerDynamicArray *array) {
-    free(array->data);
+    if (array->mapped)
+        munmap(array->data, array->capacity * sizeof(int));
+    else
+        free(array->data);
     array->data = NULL;
     array->size = 0;
     array->capacity = 0;
+    array->mapped = false;
+}
+
+// Set the factor by which capacity grows when the array is full (> 1).
+// Smaller factors waste less memory on huge arrays at the cost of more
+// (cheap, for mapped buffers) resizes.
+bool setGrowthFactorIntegerDynamicArray(IntegerDynamicArray *array,
+                                        double growthFactor) {
+    if (!(growthFactor > 1.0)) {
+        fprintf(stderr, "Invalid growth factor: %f, must be > 1\n",
+                growthFactor);
+        return false;
+    }
+    array->growthFactor = growthFactor;
+    return true;
+}
+
+// Make room for at least `capacity` elements in a single resize
+bool reserveIntegerDynamicArray(IntegerDynamicArray *array, size_t capacity) {
+    if (capacity <= array->capacity)
+        return true;
+    return resizeIntegerDynamicArray(array, capacity);
+}
+
+// Shrink the array to `newSize` elements, keeping its capacity. Whole pages
+// of a mapped buffer past the new end are handed back to the kernel with
+// MADV_DONTNEED; they read as zero and are faulted in again on reuse.
+bool truncateIntegerDynamicArray(IntegerDynamicArray *array, size_t newSize) {
+    if (newSize > array->size) {
+        fprintf(stderr, "Cannot truncate to %zu elements (size %zu)\n",
+                newSize, array->size);
+        return false;
+    }
+    array->size = newSize;
+    if (array->mapped) {
+        size_t keep = pageAlign(newSize * sizeof(int));
+        size_t bytes = array->capacity * sizeof(int);
+        if (keep < bytes)
+            madvise((char *)array->data + keep, bytes - keep, MADV_DONTNEED);
+    }
+    return true;
+}
+
+// Reduce the capacity to the current size (to whole pages for mappings)
+bool shrinkToFitIntegerDynamicArray(IntegerDynamicArray *array) {
+    if (array->size == array->capacity)
+        return true;
+    return resizeIntegerDynamicArray(array, array->size);
 }
 
 // Append a value to the end of the dynamic integer array
 bool appendIntegerDynamicArray(IntegerDynamicArray *array, int value) {
     if (array->size == array->capacity) {
-        // If the array is full, double the capacity to hold more elements
-        size_t newCapacity = array->capacity * 2;
-        int *newData = (int *)realloc(array->data, newCapacity * sizeof(int));
-        if (newData == NULL) {
+        // If the array is full, grow the capacity by the growth factor
+        size_t newCapacity =
+            (size_t)((double)array->capacity * array->growthFactor);
+        if (newCapacity <= array->capacity)
+            newCapacity = array->capacity + 1;
+        if (!resizeIntegerDynamicArray(array, newCapacity)) {
             fprintf(stderr, "Memory allocation failed during append\n");
             return false;
         }
-        array->data = newData;
-        array->capacity = newCapacity;
     }
     array->data[array->size++] = value;
     return true;
 }
 
+// ---------------------------------------------------------------------------
+// Vectorized scans
+//
+// Every search is a range predicate lo <= x <= lo + d (equality is d = 0),
+// evaluated as the single unsigned compare (unsigned)(x - lo) <= d: values
+// below lo wrap around to large numbers. Each instruction set provides one
+// kernel producing the match mask of a 64-element block; find, count, findAll
+// and bitmap drivers are stamped out per instruction set around it so that
+// the kernel inlines. The best set supported by the CPU is picked once at
+// load time through CPUID.
+// ---------------------------------------------------------------------------
+
+#define SCAN_BLOCK 64
+
+typedef struct {
+    const char *name;
+    size_t (*find)(const int *data, size_t n, int lo, uint32_t d);
+    size_t (*count)(const int *data, size_t n, int lo, uint32_t d);
+    size_t (*findAll)(const int *data, size_t n, int lo, uint32_t d,
+                      size_t *indices);
+    void (*bitmap)(const int *data, size_t n, int lo, uint32_t d,
+                   uint64_t *bitmap);
+    size_t (*removeAll)(int *data, size_t n, int lo, uint32_t d);
+} IntegerScanKernels;
+
+static inline bool scanMatch(int x, int lo, uint32_t d) {
+    return (uint32_t)x - (uint32_t)lo <= d;
+}
+
+static inline uint64_t matchBlockScalar(const int *p, int lo, uint32_t d) {
+    uint64_t mask = 0;
+    for (int j = 0; j < SCAN_BLOCK; j++)
+        mask |= (uint64_t)scanMatch(p[j], lo, d) << j;
+    return mask;
+}
+
+#ifdef HAVE_X86_KERNELS
+// SSE4.1 provides the unsigned minimum: x <= d  <=>  min(x, d) == x
+__attribute__((target("sse4.2"))) static inline uint64_t
+matchBlockSse42(const int *p, int lo, uint32_t d) {
+    __m128i vlo = _mm_set1_epi32(lo), vd = _mm_set1_epi32((int)d);
+    uint64_t mask = 0;
+    for (int j = 0; j < SCAN_BLOCK; j += 4) {
+        __m128i x =
+            _mm_sub_epi32(_mm_loadu_si128((const __m128i *)(p + j)), vlo);
+        __m128i in = _mm_cmpeq_epi32(_mm_min_epu32(x, vd), x);
+        mask |= (uint64_t)_mm_movemask_ps(_mm_castsi128_ps(in)) << j;
+    }
+    return mask;
+}
+
+__attribute__((target("avx2"))) static inline uint64_t
+matchBlockAvx2(const int *p, int lo, uint32_t d) {
+    __m256i vlo = _mm256_set1_epi32(lo), vd = _mm256_set1_epi32((int)d);
+    uint64_t mask = 0;
+    for (int j = 0; j < SCAN_BLOCK; j += 8) {
+        __m256i x = _mm256_sub_epi32(
+            _mm256_loadu_si256((const __m256i *)(p + j)), vlo);
+        __m256i in = _mm256_cmpeq_epi32(_mm256_min_epu32(x, vd), x);
+        mask |= (uint64_t)_mm256_movemask_ps(_mm256_castsi256_ps(in)) << j;
+    }
+    return mask;
+}
+
+__attribute__((target("avx512f"))) static inline uint64_t
+matchBlockAvx512(const int *p, int lo, uint32_t d) {
+    __m512i vlo = _mm512_set1_epi32(lo), vd = _mm512_set1_epi32((int)d);
+    uint64_t mask = 0;
+    for (int j = 0; j < SCAN_BLOCK; j += 16) {
+        __m512i x = _mm512_sub_epi32(_mm512_loadu_si512(p + j), vlo);
+        mask |= (uint64_t)_mm512_cmple_epu32_mask(x, vd) << j;
+    }
+    return mask;
+}
+#endif
+
+// Drivers over whole blocks plus a scalar tail, for one block kernel
+#define DEFINE_SCAN_KERNELS(isa, attributes)                                  \
+    attributes static size_t scanFind##isa(const int *data, size_t n, int lo, \
+                                           uint32_t d) {                      \
+        size_t i = 0;                                                         \
+        for (; i + SCAN_BLOCK <= n; i += SCAN_BLOCK) {                        \
+            uint64_t mask = matchBlock##isa(data + i, lo, d);                 \
+            if (mask)                                                         \
+                return i + (size_t)__builtin_ctzll(mask);                     \
+        }                                                                     \
+        for (; i < n; i++) {                                                  \
+            if (scanMatch(data[i], lo, d))                                    \
+                return i;                                                     \
+        }                                                                     \
+        return n;                                                             \
+    }                                                                         \
+    attributes static size_t scanCount##isa(const int *data, size_t n,        \
+                                            int lo, uint32_t d) {             \
+        size_t count = 0, i = 0;                                              \
+        for (; i + SCAN_BLOCK <= n; i += SCAN_BLOCK)                          \
+            count += (size_t)__builtin_popcountll(                            \
+                matchBlock##isa(data + i, lo, d));                            \
+        for (; i < n; i++)                                                    \
+            count += scanMatch(data[i], lo, d);                               \
+        return count;                                                         \
+    }                                                                         \
+    attributes static size_t scanFindAll##isa(                                \
+        const int *data, size_t n, int lo, uint32_t d, size_t *indices) {     \
+        size_t count = 0, i = 0;                                              \
+        for (; i + SCAN_BLOCK <= n; i += SCAN_BLOCK) {                        \
+            uint64_t mask = matchBlock##isa(data + i, lo, d);                 \
+            while (mask) {                                                    \
+                indices[count++] = i + (size_t)__builtin_ctzll(mask);         \
+                mask &= mask - 1;                                             \
+            }                                                                 \
+        }                                                                     \
+        for (; i < n; i++) {                                                  \
+            if (scanMatch(data[i], lo, d))                                    \
+                indices[count++] = i;                                         \
+        }                                                                     \
+        return count;                                                         \
+    }                                                                         \
+    attributes static void scanBitmap##isa(const int *data, size_t n, int lo, \
+                                           uint32_t d, uint64_t *bitmap) {    \
+        size_t i = 0;                                                         \
+        for (; i + SCAN_BLOCK <= n; i += SCAN_BLOCK)                          \
+            bitmap[i / SCAN_BLOCK] = matchBlock##isa(data + i, lo, d);        \
+        if (i < n) {                                                          \
+            uint64_t mask = 0;                                                \
+            for (size_t j = i; j < n; j++)                                    \
+                mask |= (uint64_t)scanMatch(data[j], lo, d) << (j - i);       \
+            bitmap[i / SCAN_BLOCK] = mask;                                    \
+        }                                                                     \
+    }                                                                         \
+    attributes static size_t scanRemoveAll##isa(int *data, size_t n, int lo,  \
+                                                uint32_t d) {                 \
+        size_t kept = 0, i = 0;                                               \
+        for (; i + SCAN_BLOCK <= n; i += SCAN_BLOCK) {                        \
+            uint64_t keep = ~matchBlock##isa(data + i, lo, d);                \
+            if (keep == ~0ULL) {                                              \
+                if (kept != i)                                                \
+                    memmove(data + kept, data + i, SCAN_BLOCK * sizeof(int)); \
+                kept += SCAN_BLOCK;                                           \
+                continue;                                                     \
+            }                                                                 \
+            while (keep) {                                                    \
+                data[kept++] = data[i + (size_t)__builtin_ctzll(keep)];       \
+                keep &= keep - 1;                                             \
+            }                                                                 \
+        }                                                                     \
+        for (; i < n; i++) {                                                  \
+            if (!scanMatch(data[i], lo, d))                                   \
+                data[kept++] = data[i];                                       \
+        }                                                                     \
+        return kept;                                                          \
+    }
+
+DEFINE_SCAN_KERNELS(Scalar, )
+#ifdef HAVE_X86_KERNELS
+DEFINE_SCAN_KERNELS(Sse42, __attribute__((target("sse4.2,popcnt"))))
+DEFINE_SCAN_KERNELS(Avx2, __attribute__((target("avx2,popcnt"))))
+DEFINE_SCAN_KERNELS(Avx512, __attribute__((target("avx512f,popcnt"))))
+#endif
+
+// Kernel sets from the most portable to the widest
+static const IntegerScanKernels scanKernelTable[] = {
+    {"scalar", scanFindScalar, scanCountScalar, scanFindAllScalar,
+     scanBitmapScalar, scanRemoveAllScalar},
+#ifdef HAVE_X86_KERNELS
+    {"sse4.2", scanFindSse42, scanCountSse42, scanFindAllSse42,
+     scanBitmapSse42, scanRemoveAllSse42},
+    {"avx2", scanFindAvx2, scanCountAvx2, scanFindAllAvx2, scanBitmapAvx2,
+     scanRemoveAllAvx2},
+    {"avx512", scanFindAvx512, scanCountAvx512, scanFindAllAvx512,
+     scanBitmapAvx512, scanRemoveAllAvx512},
+#endif
+};
+
+static const IntegerScanKernels *scanKernels = &scanKernelTable[0];
+
+// Is the given kernel set usable on this CPU?
+static bool scanKernelsSupported(const IntegerScanKernels *kernels) {
+#ifdef HAVE_X86_KERNELS
+    __builtin_cpu_init();
+    if (kernels == &scanKernelTable[1])
+        return __builtin_cpu_supports("sse4.2");
+    if (kernels == &scanKernelTable[2])
+        return __builtin_cpu_supports("avx2");
+    if (kernels == &scanKernelTable[3])
+        return __builtin_cpu_supports("avx512f");
+#endif
+    return kernels == &scanKernelTable[0];
+}
+
+// Select the widest supported kernel set before main() runs
+__attribute__((constructor)) static void selectScanKernels(void) {
+    size_t count = sizeof(scanKernelTable) / sizeof(*scanKernelTable);
+    for (size_t i = count; i-- > 0;) {
+        if (scanKernelsSupported(&scanKernelTable[i])) {
+            scanKernels = &scanKernelTable[i];
+            return;
+        }
+    }
+}
+
+// Convert the half-open range [lo, hi) to the (lo, d) form of the kernels.
+// Return false if the range is empty.
+static inline bool scanRange(int lo, int hi, uint32_t *d) {
+    if (hi <= lo)
+        return false;
+    *d = (uint32_t)hi - (uint32_t)lo - 1;
+    return true;
+}
+
 // Find the index of the first occurrence of the given value in the dynamic
 // integer array Returns true and sets *index if found; returns false otherwise.
 bool findIntegerDynamicArray(IntegerDynamicArray *array, int value,
                              size_t *index) {
-    for (size_t i = 0; i < array->size; i++) {
-        if (array->data[i] == value) {
-            *index = i;
-            return true;
-        }
+    size_t i = scanKernels->find(array->data, array->size, value, 0);
+    if (i == array->size)
+        return false;
+    *index = i;
+    return true;
+}
+
+// Find the index of the first element with lo <= x < hi.
+// Returns true and sets *index if found; returns false otherwise.
+bool findRangeIntegerDynamicArray(IntegerDynamicArray *array, int lo, int hi,
+                                  size_t *index) {
+    uint32_t d;
+    if (!scanRange(lo, hi, &d))
+        return false;
+    size_t i = scanKernels->find(array->data, array->size, lo, d);
+    if (i == array->size)
+        return false;
+    *index = i;
+    return true;
+}
+
+// Count the occurrences of the given value
+size_t countIntegerDynamicArray(IntegerDynamicArray *array, int value) {
+    return scanKernels->count(array->data, array->size, value, 0);
+}
+
+// Count the elements with lo <= x < hi
+size_t countRangeIntegerDynamicArray(IntegerDynamicArray *array, int lo,
+                                     int hi) {
+    uint32_t d;
+    if (!scanRange(lo, hi, &d))
+        return 0;
+    return scanKernels->count(array->data, array->size, lo, d);
+}
+
+// Write the indices of all occurrences of the given value to `indices` in
+// ascending order and return how many there are. `indices` must have room
+// for countIntegerDynamicArray() (at most array->size) entries.
+size_t findAllIntegerDynamicArray(IntegerDynamicArray *array, int value,
+                                  size_t *indices) {
+    return scanKernels->findAll(array->data, array->size, value, 0, indices);
+}
+
+// Write the indices of all elements with lo <= x < hi to `indices`, as
+// findAllIntegerDynamicArray() does, and return how many there are
+size_t findAllRangeIntegerDynamicArray(IntegerDynamicArray *array, int lo,
+                                       int hi, size_t *indices) {
+    uint32_t d;
+    if (!scanRange(lo, hi, &d))
+        return 0;
+    return scanKernels->findAll(array->data, array->size, lo, d, indices);
+}
+
+// Set bit i of `bitmap` (i % 64 of word i / 64) iff lo <= data[i] < hi.
+// `bitmap` must hold (array->size + 63) / 64 words.
+void matchBitmapRangeIntegerDynamicArray(IntegerDynamicArray *array, int lo,
+                                         int hi, uint64_t *bitmap) {
+    uint32_t d;
+    if (!scanRange(lo, hi, &d)) {
+        for (size_t w = 0; w < (array->size + 63) / 64; w++)
+            bitmap[w] = 0;
+        return;
     }
-    return false;
+    scanKernels->bitmap(array->data, array->size, lo, d, bitmap);
 }
 
 // Delete the first occurrence of the given value in the dynamic integer array
@@ -70,13 +466,254 @@ bool deleteIntegerDynamicArray(IntegerDynamicArray *array, int value) {
         return false;
     }
     // Shift elements to fill the gap
-    for (size_t i = index; i < array->size - 1; i++) {
-        array->data[i] = array->data[i + 1];
-    }
+    memmove(array->data + index, array->data + index + 1,
+            (array->size - index - 1) * sizeof(int));
     array->size--;
     return true;
 }
 
+// Remove the element at `index` in O(1) by moving the last element into its
+// place. The order of the remaining elements is not preserved.
+bool swapRemoveIntegerDynamicArray(IntegerDynamicArray *array, size_t index) {
+    if (index >= array->size) {
+        fprintf(stderr, "Index %zu out of range (size %zu), cannot remove\n",
+                index, array->size);
+        return false;
+    }
+    array->data[index] = array->data[--array->size];
+    return true;
+}
+
+// Remove the elements at indices [first, last) with a single memmove of the
+// tail
+bool eraseRangeIntegerDynamicArray(IntegerDynamicArray *array, size_t first,
+                                   size_t last) {
+    if (first > last || last > array->size) {
+        fprintf(stderr, "Invalid range [%zu, %zu) for size %zu, cannot erase\n",
+                first, last, array->size);
+        return false;
+    }
+    memmove(array->data + first, array->data + last,
+            (array->size - last) * sizeof(int));
+    array->size -= last - first;
+    return true;
+}
+
+// Remove every element for which predicate(value, context) returns true,
+// keeping the order of the rest, in one streaming pass. Returns the number
+// of elements removed.
+size_t removeIfIntegerDynamicArray(IntegerDynamicArray *array,
+                                   bool (*predicate)(int value, void *context),
+                                   void *context) {
+    size_t kept = 0;
+    for (size_t i = 0; i < array->size; i++) {
+        int value = array->data[i];
+        if (!predicate(value, context))
+            array->data[kept++] = value;
+    }
+    size_t removed = array->size - kept;
+    array->size = kept;
+    return removed;
+}
+
+// Remove every occurrence of `value` in one vectorized pass, keeping order.
+// Returns the number of elements removed.
+size_t removeAllIntegerDynamicArray(IntegerDynamicArray *array, int value) {
+    size_t kept = scanKernels->removeAll(array->data, array->size, value, 0);
+    size_t removed = array->size - kept;
+    array->size = kept;
+    return removed;
+}
+
+// Remove every element with lo <= x < hi in one vectorized pass, keeping
+// order. Returns the number of elements removed.
+size_t removeRangeIntegerDynamicArray(IntegerDynamicArray *array, int lo,
+                                      int hi) {
+    uint32_t d;
+    if (!scanRange(lo, hi, &d))
+        return 0;
+    size_t kept = scanKernels->removeAll(array->data, array->size, lo, d);
+    size_t removed = array->size - kept;
+    array->size = kept;
+    return removed;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Scan throughput of every kernel set the CPU supports, against the plain
+// one-element-at-a-time loop
+static void benchmarkScans(size_t n) {
+    IntegerDynamicArray big;
+    if (!initializeIntegerDynamicArray(&big, n))
+        return;
+    uint32_t state = 2463534242u;
+    for (size_t i = 0; i < n; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        big.data[i] = (int)(state % 1000000);
+    }
+    big.size = n;
+    double gigabytes = (double)(n * sizeof(int)) / 1e9;
+
+    // Baseline: the original scalar loop, searching for an absent value
+    double start = nowSeconds();
+    size_t found = n;
+    for (size_t i = 0; i < n; i++) {
+        if (big.data[i] == -1) {
+            found = i;
+            break;
+        }
+    }
+    double loop = nowSeconds() - start;
+    printf("%-8s find %6.2f GB/s%s\n", "loop", gigabytes / loop,
+           found == n ? "" : " (unexpected match)");
+
+    const IntegerScanKernels *best = scanKernels;
+    size_t count = sizeof(scanKernelTable) / sizeof(*scanKernelTable);
+    for (size_t k = 0; k < count; k++) {
+        if (!scanKernelsSupported(&scanKernelTable[k]))
+            continue;
+        scanKernels = &scanKernelTable[k];
+        size_t index;
+        start = nowSeconds();
+        bool hit = findIntegerDynamicArray(&big, -1, &index);
+        double middle = nowSeconds();
+        size_t matches = countRangeIntegerDynamicArray(&big, 1000, 2000);
+        double end = nowSeconds();
+        printf("%-8s find %6.2f GB/s, count range %6.2f GB/s "
+               "(%zu matches)%s\n",
+               scanKernels->name, gigabytes / (middle - start),
+               gigabytes / (end - middle), matches, hit ? " (bad find)" : "");
+    }
+    scanKernels = best;
+    freeIntegerDynamicArray(&big);
+}
+
+// Value set for removeIfIntegerDynamicArray: a bitmap over [0, 1M)
+static bool inValueSet(int value, void *context) {
+    const uint64_t *bitmap = context;
+    return value >= 0 && value < 1000000 &&
+           (bitmap[value / 64] >> (value % 64) & 1);
+}
+
+// Remove 1000 distinct values from n elements: repeated deletes, one
+// predicate pass, and one vectorized range pass
+static void benchmarkRemoval(size_t n) {
+    IntegerDynamicArray original, work;
+    if (!initializeIntegerDynamicArray(&original, n))
+        return;
+    if (!initializeIntegerDynamicArray(&work, n)) {
+        freeIntegerDynamicArray(&original);
+        return;
+    }
+    uint32_t state = 2463534242u;
+    for (size_t i = 0; i < n; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        original.data[i] = (int)(state % 1000000);
+    }
+    original.size = n;
+
+    // Baseline: delete each occurrence of 0..999 one at a time
+    memcpy(work.data, original.data, n * sizeof(int));
+    work.size = n;
+    double start = nowSeconds();
+    size_t index;
+    for (int v = 0; v < 1000; v++) {
+        while (findIntegerDynamicArray(&work, v, &index))
+            deleteIntegerDynamicArray(&work, v);
+    }
+    double repeated = nowSeconds() - start;
+    size_t expected = work.size;
+
+    uint64_t valueSet[1000000 / 64 + 1] = {0};
+    for (int v = 0; v < 1000; v++)
+        valueSet[v / 64] |= 1ULL << (v % 64);
+    memcpy(work.data, original.data, n * sizeof(int));
+    work.size = n;
+    start = nowSeconds();
+    removeIfIntegerDynamicArray(&work, inValueSet, valueSet);
+    double predicate = nowSeconds() - start;
+    bool same = work.size == expected;
+
+    memcpy(work.data, original.data, n * sizeof(int));
+    work.size = n;
+    start = nowSeconds();
+    removeRangeIntegerDynamicArray(&work, 0, 1000);
+    double vectorized = nowSeconds() - start;
+    same &= work.size == expected;
+
+    printf("repeated delete %8.2f ms, removeIf %6.2f ms, removeRange "
+           "(%s) %6.2f ms, %zu removed%s\n",
+           repeated * 1e3, predicate * 1e3, scanKernels->name,
+           vectorized * 1e3, n - expected, same ? "" : "  MISMATCH");
+    freeIntegerDynamicArray(&original);
+    freeIntegerDynamicArray(&work);
+}
+
+// Append n values under one growth strategy in a child process, so that
+// the child's peak RSS (from wait4) belongs to this run alone
+static void benchmarkGrowth(const char *label, size_t n, double growthFactor,
+                            bool reserve, bool heapOnly) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return;
+    }
+    if (pid == 0) {
+        double start = nowSeconds();
+        if (heapOnly) {
+            // The original engine: realloc() doubling
+            int *data = malloc(4 * sizeof(int));
+            size_t capacity = 4;
+            for (size_t i = 0; i < n; i++) {
+                if (i == capacity) {
+                    capacity *= 2;
+                    int *newData = realloc(data, capacity * sizeof(int));
+                    if (!newData)
+                        _exit(EXIT_FAILURE);
+                    data = newData;
+                }
+                data[i] = (int)i;
+            }
+            free(data);
+        } else {
+            IntegerDynamicArray array;
+            if (!initializeIntegerDynamicArray(&array, 4) ||
+                !setGrowthFactorIntegerDynamicArray(&array, growthFactor) ||
+                (reserve && !reserveIntegerDynamicArray(&array, n)))
+                _exit(EXIT_FAILURE);
+            for (size_t i = 0; i < n; i++) {
+                if (!appendIntegerDynamicArray(&array, (int)i))
+                    _exit(EXIT_FAILURE);
+            }
+            freeIntegerDynamicArray(&array);
+        }
+        double elapsed = nowSeconds() - start;
+        printf("%-22s %7.0f M appends/s, ", label,
+               (double)n / elapsed / 1e6);
+        fflush(stdout);
+        _exit(EXIT_SUCCESS);
+    }
+
+    int status;
+    struct rusage usage;
+    if (wait4(pid, &status, 0, &usage) < 0 || !WIFEXITED(status) ||
+        WEXITSTATUS(status) != EXIT_SUCCESS) {
+        printf("%-22s failed\n", label);
+        return;
+    }
+    printf("peak RSS %6ld MB (data %zu MB)\n", usage.ru_maxrss / 1024,
+           n * sizeof(int) >> 20);
+}
+
 // Main function to demonstrate the usage of the dynamic integer array
 int main(void) {
     IntegerDynamicArray vec;
@@ -123,7 +760,56 @@ int main(void) {
     }
     printf("\n");
 
+    // Vectorized searches over a repeating pattern
+    for (int i = 0; i < 200; i++)
+        appendIntegerDynamicArray(&vec, i % 7);
+    size_t indices[8];
+    size_t matches = findAllRangeIntegerDynamicArray(&vec, 8, 10, indices);
+    printf("Using %s kernels: %zu sixes, %zu values in [2, 5), "
+           "values in [8, 10) at",
+           scanKernels->name, countIntegerDynamicArray(&vec, 6),
+           countRangeIntegerDynamicArray(&vec, 2, 5));
+    for (size_t i = 0; i < matches; i++)
+        printf(" %zu", indices[i]);
+    printf("\n");
+
+    // Bulk removal keeps order; swap-remove does not
+    size_t removed = removeRangeIntegerDynamicArray(&vec, 1, 6);
+    eraseRangeIntegerDynamicArray(&vec, 0, 5);
+    swapRemoveIntegerDynamicArray(&vec, 0);
+    printf("Removed %zu values in [1, 6), erased 5, swap-removed the first:",
+           removed);
+    for (size_t i = 0; i < vec.size && i < 12; i++)
+        printf(" %d", vec.data[i]);
+    printf(" ... (%zu left)\n", vec.size);
+
     // Clean up
     freeIntegerDynamicArray(&vec);
+
+    printf("\nRemoving the values 0..999 from 1M elements:\n");
+    benchmarkRemoval(1000000);
+
+    printf("\nScanning 256M elements (1 GB):\n");
+    benchmarkScans(256u << 20);
+
+    // 2 GB of appends, one child process per strategy
+    size_t n = 512u << 20;
+    printf("\nAppending 512M elements:\n");
+    benchmarkGrowth("realloc doubling", n, 2.0, false, true);
+    benchmarkGrowth("mremap, factor 2", n, 2.0, false, false);
+    benchmarkGrowth("mremap, factor 1.25", n, 1.25, false, false);
+    benchmarkGrowth("reserve up front", n, 2.0, true, false);
+
+    // Truncation releases the pages past the new end
+    IntegerDynamicArray big;
+    if (initializeIntegerDynamicArray(&big, 4)) {
+        for (size_t i = 0; i < (64u << 20); i++)
+            appendIntegerDynamicArray(&big, (int)i);
+        truncateIntegerDynamicArray(&big, 1u << 20);
+        shrinkToFitIntegerDynamicArray(&big);
+        printf("Truncated a 256 MB array to %zu elements (capacity %zu)\n",
+               big.size, big.capacity);
+        freeIntegerDynamicArray(&big);
+    }
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,482 @@
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+// Structure to hold the dynamic integer array (as in integerDynamicArray.c)
+typedef struct {
+    int *data;       // Pointer to the array holding the data
+    size_t size;     // Current number of elements in the array
+    size_t capacity; // Current capacity of the array (adjustable)
+} IntegerDynamicArray;
+
+// ---------------------------------------------------------------------------
+// Persistent integer array
+//
+// The array lives in a file: one header page followed by the elements, and
+// the whole file is mapped MAP_SHARED. Opening is O(1) whatever the size --
+// there is nothing to read or parse, pages are faulted in from the page
+// cache on first touch, and every process mapping the file shares those
+// pages. Appends extend the file with ftruncate() and grow the mapping with
+// mremap().
+//
+// The header is only rewritten by syncPersistentIntegerArray(), after the
+// data it describes has been flushed, so a crash loses at most the appends
+// since the last sync. It records the element width, the element count and
+// a checksum of those elements (an additive and a position-weighted sum,
+// updated in O(1) on every append and store), and is protected by its own
+// checksum, which is checked on every open.
+// ---------------------------------------------------------------------------
+
+#define PERSISTENT_MAGIC "IDARRAY1"
+#define PERSISTENT_VERSION 1
+// Keep the elements page-aligned after the header
+#define PERSISTENT_HEADER_BYTES 4096
+// The file grows by its own size, but by at least 1 MB and at most 1 GB
+#define PERSISTENT_MIN_GROWTH ((size_t)1 << 20)
+#define PERSISTENT_MAX_GROWTH ((size_t)1 << 30)
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t elementWidth;   // sizeof(int) of the writer
+    uint64_t count;          // Elements covered by the last sync
+    uint64_t sum;            // Sum of the elements, modulo 2^64
+    uint64_t weightedSum;    // Sum of (index + 1) * element, modulo 2^64
+    uint64_t headerChecksum; // FNV-1a of all the fields above
+} PersistentArrayHeader;
+
+typedef struct {
+    // View of the elements: data points into the mapping, so functions that
+    // only read an IntegerDynamicArray work on it without a copy
+    IntegerDynamicArray array;
+    int fd;
+    bool writable;
+    char *mapping;        // Header page followed by the elements
+    size_t mappedBytes;   // Length of the mapping (the file size)
+    size_t dirtyFrom;     // First element written since the last sync
+    bool grown;           // The file was extended since the last sync
+    uint64_t sum;         // Checksum of the current array.size elements
+    uint64_t weightedSum;
+} PersistentIntegerArray;
+
+static uint64_t headerChecksum(const PersistentArrayHeader *header) {
+    const unsigned char *bytes = (const unsigned char *)header;
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < offsetof(PersistentArrayHeader, headerChecksum);
+         i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+static PersistentArrayHeader *header(PersistentIntegerArray *p) {
+    return (PersistentArrayHeader *)p->mapping;
+}
+
+// Map (or remap) the first `bytes` bytes of the file
+static bool mapPersistentIntegerArray(PersistentIntegerArray *p,
+                                      size_t bytes) {
+    void *mapping;
+    if (p->mapping) {
+        mapping = mremap(p->mapping, p->mappedBytes, bytes, MREMAP_MAYMOVE);
+    } else {
+        int protection = PROT_READ | (p->writable ? PROT_WRITE : 0);
+        mapping = mmap(NULL, bytes, protection, MAP_SHARED, p->fd, 0);
+    }
+    if (mapping == MAP_FAILED) {
+        perror("Mapping the array file failed");
+        return false;
+    }
+    p->mapping = mapping;
+    p->mappedBytes = bytes;
+    p->array.data = (int *)(p->mapping + PERSISTENT_HEADER_BYTES);
+    p->array.capacity = (bytes - PERSISTENT_HEADER_BYTES) / sizeof(int);
+    return true;
+}
+
+// Check the header and take its count; false if the file is not a valid
+// array file
+static bool loadHeader(PersistentIntegerArray *p) {
+    const PersistentArrayHeader *h = header(p);
+    if (memcmp(h->magic, PERSISTENT_MAGIC, sizeof(h->magic)) != 0 ||
+        h->version != PERSISTENT_VERSION) {
+        fprintf(stderr, "Not a persistent integer array file\n");
+        return false;
+    }
+    if (h->headerChecksum != headerChecksum(h)) {
+        fprintf(stderr, "Persistent array header checksum mismatch\n");
+        return false;
+    }
+    if (h->elementWidth != sizeof(int)) {
+        fprintf(stderr, "Element width %u does not match int (%zu)\n",
+                h->elementWidth, sizeof(int));
+        return false;
+    }
+    if (h->count > p->array.capacity) {
+        fprintf(stderr, "File truncated: header claims %lu elements\n",
+                (unsigned long)h->count);
+        return false;
+    }
+    p->array.size = h->count;
+    p->dirtyFrom = h->count;
+    p->sum = h->sum;
+    p->weightedSum = h->weightedSum;
+    return true;
+}
+
+// Open the array stored at `path`. A writable open creates the file if it
+// is missing or empty; a read-only open maps it PROT_READ and can follow a
+// writer with refreshPersistentIntegerArray().
+bool openPersistentIntegerArray(PersistentIntegerArray *p, const char *path,
+                                bool writable) {
+    memset(p, 0, sizeof(*p));
+    p->writable = writable;
+    p->fd = open(path, writable ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+    if (p->fd < 0) {
+        perror("Opening the array file failed");
+        return false;
+    }
+    struct stat st;
+    if (fstat(p->fd, &st) != 0) {
+        perror("fstat");
+        close(p->fd);
+        return false;
+    }
+
+    size_t bytes = (size_t)st.st_size;
+    bool created = bytes == 0 && writable;
+    if (created) {
+        bytes = PERSISTENT_HEADER_BYTES + PERSISTENT_MIN_GROWTH;
+        if (ftruncate(p->fd, (off_t)bytes) != 0) {
+            perror("Sizing the new array file failed");
+            close(p->fd);
+            return false;
+        }
+    } else if (bytes < PERSISTENT_HEADER_BYTES) {
+        fprintf(stderr, "Not a persistent integer array file: %s\n", path);
+        close(p->fd);
+        return false;
+    }
+    if (!mapPersistentIntegerArray(p, bytes)) {
+        close(p->fd);
+        return false;
+    }
+
+    if (created) {
+        PersistentArrayHeader *h = header(p);
+        memcpy(h->magic, PERSISTENT_MAGIC, sizeof(h->magic));
+        h->version = PERSISTENT_VERSION;
+        h->elementWidth = sizeof(int);
+        h->headerChecksum = headerChecksum(h);
+        p->grown = true;
+    }
+    if (!loadHeader(p)) {
+        munmap(p->mapping, p->mappedBytes);
+        close(p->fd);
+        return false;
+    }
+    return true;
+}
+
+// Flush the elements written since the last sync, then the header that
+// covers them. When this returns true, a reopen after a crash sees every
+// element appended or stored so far.
+bool syncPersistentIntegerArray(PersistentIntegerArray *p) {
+    if (!p->writable)
+        return true;
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t from = PERSISTENT_HEADER_BYTES + p->dirtyFrom * sizeof(int);
+    size_t to = PERSISTENT_HEADER_BYTES + p->array.size * sizeof(int);
+    from = from / page * page;
+    if (from < to && msync(p->mapping + from, to - from, MS_SYNC) != 0) {
+        perror("Flushing the array data failed");
+        return false;
+    }
+    // A grown file also needs its new size on disk before the header
+    // claims the elements past the old end
+    if (p->grown && fdatasync(p->fd) != 0) {
+        perror("Flushing the array file size failed");
+        return false;
+    }
+
+    PersistentArrayHeader *h = header(p);
+    h->count = p->array.size;
+    h->sum = p->sum;
+    h->weightedSum = p->weightedSum;
+    h->headerChecksum = headerChecksum(h);
+    if (msync(p->mapping, PERSISTENT_HEADER_BYTES, MS_SYNC) != 0) {
+        perror("Flushing the array header failed");
+        return false;
+    }
+    p->dirtyFrom = p->array.size;
+    p->grown = false;
+    return true;
+}
+
+// Sync, trim the file to its elements and unmap it
+bool closePersistentIntegerArray(PersistentIntegerArray *p) {
+    bool ok = syncPersistentIntegerArray(p);
+    size_t used = PERSISTENT_HEADER_BYTES + p->array.size * sizeof(int);
+    munmap(p->mapping, p->mappedBytes);
+    if (p->writable && ok && ftruncate(p->fd, (off_t)used) != 0) {
+        perror("Trimming the array file failed");
+        ok = false;
+    }
+    close(p->fd);
+    p->mapping = NULL;
+    p->array = (IntegerDynamicArray){NULL, 0, 0};
+    return ok;
+}
+
+// Extend the file and the mapping to hold at least `capacity` elements
+static bool growPersistentIntegerArray(PersistentIntegerArray *p,
+                                       size_t capacity) {
+    size_t dataBytes = p->mappedBytes - PERSISTENT_HEADER_BYTES;
+    size_t step = dataBytes;
+    step = step < PERSISTENT_MIN_GROWTH ? PERSISTENT_MIN_GROWTH : step;
+    step = step > PERSISTENT_MAX_GROWTH ? PERSISTENT_MAX_GROWTH : step;
+    size_t newBytes = dataBytes + step;
+    if (newBytes < capacity * sizeof(int))
+        newBytes = capacity * sizeof(int);
+    newBytes = (newBytes + PERSISTENT_MIN_GROWTH - 1) /
+               PERSISTENT_MIN_GROWTH * PERSISTENT_MIN_GROWTH;
+    size_t fileBytes = PERSISTENT_HEADER_BYTES + newBytes;
+    if (ftruncate(p->fd, (off_t)fileBytes) != 0) {
+        perror("Extending the array file failed");
+        return false;
+    }
+    p->grown = true;
+    return mapPersistentIntegerArray(p, fileBytes);
+}
+
+// Make room for at least `capacity` elements in one file extension
+bool reservePersistentIntegerArray(PersistentIntegerArray *p,
+                                   size_t capacity) {
+    if (!p->writable) {
+        fprintf(stderr, "Cannot reserve space in a read-only array\n");
+        return false;
+    }
+    if (capacity <= p->array.capacity)
+        return true;
+    return growPersistentIntegerArray(p, capacity);
+}
+
+// Append a value to the end of the persistent array
+bool appendPersistentIntegerArray(PersistentIntegerArray *p, int value) {
+    if (!p->writable) {
+        fprintf(stderr, "Cannot append to a read-only array\n");
+        return false;
+    }
+    IntegerDynamicArray *array = &p->array;
+    if (array->size == array->capacity &&
+        !growPersistentIntegerArray(p, array->size + 1))
+        return false;
+    array->data[array->size] = value;
+    p->sum += (uint64_t)(int64_t)value;
+    p->weightedSum += (uint64_t)(array->size + 1) * (uint64_t)(int64_t)value;
+    array->size++;
+    return true;
+}
+
+// Overwrite the element at `index`
+bool setPersistentIntegerArray(PersistentIntegerArray *p, size_t index,
+                               int value) {
+    if (!p->writable) {
+        fprintf(stderr, "Cannot store into a read-only array\n");
+        return false;
+    }
+    if (index >= p->array.size) {
+        fprintf(stderr, "Index %zu out of range (size %zu), cannot set\n",
+                index, p->array.size);
+        return false;
+    }
+    uint64_t delta =
+        (uint64_t)((int64_t)value - (int64_t)p->array.data[index]);
+    p->sum += delta;
+    p->weightedSum += (uint64_t)(index + 1) * delta;
+    p->array.data[index] = value;
+    if (index < p->dirtyFrom)
+        p->dirtyFrom = index;
+    return true;
+}
+
+// Pick up the elements a writer has synced since this reader opened or last
+// refreshed. Return false if the header could not be read consistently
+// (for example while the writer is updating it); the view is unchanged.
+bool refreshPersistentIntegerArray(PersistentIntegerArray *p) {
+    if (p->writable)
+        return true;
+    PersistentArrayHeader snapshot = *header(p);
+    if (snapshot.headerChecksum != headerChecksum(&snapshot))
+        return false;
+    if (snapshot.count > p->array.capacity) {
+        struct stat st;
+        if (fstat(p->fd, &st) != 0) {
+            perror("fstat");
+            return false;
+        }
+        if (!mapPersistentIntegerArray(p, (size_t)st.st_size))
+            return false;
+    }
+    p->array.size = snapshot.count;
+    p->sum = snapshot.sum;
+    p->weightedSum = snapshot.weightedSum;
+    return true;
+}
+
+// Recompute the checksum over every element and compare it with the one
+// maintained since the last open. O(n); opening never does this.
+bool verifyPersistentIntegerArray(PersistentIntegerArray *p) {
+    uint64_t sum = 0, weightedSum = 0;
+    for (size_t i = 0; i < p->array.size; i++) {
+        uint64_t value = (uint64_t)(int64_t)p->array.data[i];
+        sum += value;
+        weightedSum += (uint64_t)(i + 1) * value;
+    }
+    return sum == p->sum && weightedSum == p->weightedSum;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int64_t sumElements(const IntegerDynamicArray *array) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < array->size; i++)
+        sum += array->data[i];
+    return sum;
+}
+
+// Write n elements to `path`, then compare reopening the mapping with
+// reading the whole file into memory, and sum it from reader processes
+static void benchmark(const char *path, size_t n, int readers) {
+    unlink(path);
+    PersistentIntegerArray p;
+    if (!openPersistentIntegerArray(&p, path, true))
+        return;
+    double start = nowSeconds();
+    for (size_t i = 0; i < n; i++)
+        appendPersistentIntegerArray(&p, (int)(i * 2654435761u));
+    double appendTime = nowSeconds() - start;
+    start = nowSeconds();
+    syncPersistentIntegerArray(&p);
+    double syncTime = nowSeconds() - start;
+    int64_t expected = sumElements(&p.array);
+    closePersistentIntegerArray(&p);
+    printf("%zuM elements: append %.0f M/s, sync %.2f s\n", n >> 20,
+           (double)n / appendTime / 1e6, syncTime);
+
+    start = nowSeconds();
+    if (!openPersistentIntegerArray(&p, path, false))
+        return;
+    double openTime = nowSeconds() - start;
+    start = nowSeconds();
+    bool valid = verifyPersistentIntegerArray(&p);
+    double verifyTime = nowSeconds() - start;
+    closePersistentIntegerArray(&p);
+
+    // The alternative: read the whole file into a heap buffer
+    start = nowSeconds();
+    int fd = open(path, O_RDONLY);
+    size_t bytes = PERSISTENT_HEADER_BYTES + n * sizeof(int);
+    char *copy = malloc(bytes);
+    size_t done = 0;
+    while (fd >= 0 && copy && done < bytes) {
+        ssize_t got = read(fd, copy + done, bytes - done);
+        if (got <= 0)
+            break;
+        done += (size_t)got;
+    }
+    double readTime = nowSeconds() - start;
+    free(copy);
+    if (fd >= 0)
+        close(fd);
+    printf("open %.1f us vs read() %.3f s; full verify %.3f s (%s)\n",
+           openTime * 1e6, readTime, verifyTime, valid ? "valid" : "CORRUPT");
+
+    // Readers fault the pages in from the shared page cache: no major
+    // faults, no private copy
+    for (int r = 0; r < readers; r++) {
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid == 0) {
+            PersistentIntegerArray view;
+            if (!openPersistentIntegerArray(&view, path, false))
+                _exit(EXIT_FAILURE);
+            bool match = sumElements(&view.array) == expected;
+            closePersistentIntegerArray(&view);
+            _exit(match ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+        int status;
+        struct rusage usage;
+        if (pid < 0 || wait4(pid, &status, 0, &usage) < 0)
+            continue;
+        printf("reader %d: sum %s, %ld major / %ld minor faults\n", r,
+               WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS
+                   ? "matches"
+                   : "MISMATCH",
+               usage.ru_majflt, usage.ru_minflt);
+    }
+    unlink(path);
+}
+
+int main(void) {
+    const char *path = "/tmp/integerPersistentArray.demo";
+    unlink(path);
+    PersistentIntegerArray p;
+    if (!openPersistentIntegerArray(&p, path, true))
+        return EXIT_FAILURE;
+    for (int i = 1; i <= 10; i++)
+        appendPersistentIntegerArray(&p, i * i);
+    setPersistentIntegerArray(&p, 0, -1);
+    closePersistentIntegerArray(&p);
+
+    // A reader follows a writer that keeps appending
+    PersistentIntegerArray writer, reader;
+    openPersistentIntegerArray(&writer, path, true);
+    openPersistentIntegerArray(&reader, path, false);
+    printf("Reopened %zu elements:", reader.array.size);
+    for (size_t i = 0; i < reader.array.size; i++)
+        printf(" %d", reader.array.data[i]);
+    printf("\n");
+    for (int i = 0; i < 1000000; i++)
+        appendPersistentIntegerArray(&writer, i);
+    printf("Reader before sync: %zu elements\n", reader.array.size);
+    syncPersistentIntegerArray(&writer);
+    refreshPersistentIntegerArray(&reader);
+    printf("Reader after sync: %zu elements, checksum %s\n",
+           reader.array.size,
+           verifyPersistentIntegerArray(&reader) ? "valid" : "CORRUPT");
+    closePersistentIntegerArray(&reader);
+    closePersistentIntegerArray(&writer);
+
+    // Corrupt one header byte: the open must refuse the file
+    int fd = open(path, O_WRONLY);
+    if (fd >= 0) {
+        uint64_t bogus = 123;
+        ssize_t written = pwrite(fd, &bogus, sizeof(bogus),
+                                 offsetof(PersistentArrayHeader, count));
+        close(fd);
+        if (written == sizeof(bogus) &&
+            !openPersistentIntegerArray(&p, path, false))
+            printf("Corrupted header rejected\n\n");
+    }
+
+    benchmark(path, 256u << 20, 2);
+    unlink(path);
+    return EXIT_SUCCESS;
+}
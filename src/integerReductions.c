@@ -0,0 +1,698 @@
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_KERNELS 1
+#endif
+
+// Structure to hold the dynamic integer array (as in integerDynamicArray.c)
+typedef struct {
+    int *data;       // Pointer to the array holding the data
+    size_t size;     // Current number of elements in the array
+    size_t capacity; // Current capacity of the array (adjustable)
+} IntegerDynamicArray;
+
+// ---------------------------------------------------------------------------
+// Fork-join pool
+//
+// The caller and threads - 1 parked workers run the same task, each with its
+// own worker index, and forkJoinPoolRun() returns once all of them are done.
+// Workers stay alive between runs, so a reduction costs one broadcast and one
+// wake-up per thread instead of a pthread_create() per thread.
+// ---------------------------------------------------------------------------
+
+typedef void (*ForkJoinTask)(void *arg, size_t worker, size_t workers);
+
+typedef struct ForkJoinPool ForkJoinPool;
+
+typedef struct {
+    ForkJoinPool *pool;
+    size_t index;
+    pthread_t thread;
+} ForkJoinWorker;
+
+struct ForkJoinPool {
+    ForkJoinWorker *workers; // Workers 1 .. threads - 1 (0 is the caller)
+    size_t threads;          // Participants in each run, caller included
+    pthread_mutex_t lock;
+    pthread_cond_t start;  // Signalled when a new run is published
+    pthread_cond_t finish; // Signalled when the last worker is done
+    ForkJoinTask task;
+    void *arg;
+    uint64_t generation; // Incremented for every run
+    size_t pending;      // Workers still busy with the current run
+    bool stop;
+};
+
+static void *forkJoinWorkerRun(void *arg) {
+    ForkJoinWorker *worker = arg;
+    ForkJoinPool *pool = worker->pool;
+    uint64_t seen = 0;
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->generation == seen && !pool->stop)
+            pthread_cond_wait(&pool->start, &pool->lock);
+        if (pool->stop)
+            break;
+        seen = pool->generation;
+        ForkJoinTask task = pool->task;
+        void *taskArg = pool->arg;
+        pthread_mutex_unlock(&pool->lock);
+
+        task(taskArg, worker->index, pool->threads);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0)
+            pthread_cond_signal(&pool->finish);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+// Start a pool of `threads` participants. If some workers cannot be
+// started, the pool runs with fewer threads.
+bool forkJoinPoolInitialize(ForkJoinPool *pool, size_t threads) {
+    if (threads == 0) {
+        fprintf(stderr, "A fork-join pool needs at least one thread\n");
+        return false;
+    }
+    pool->workers = calloc(threads, sizeof(ForkJoinWorker));
+    if (!pool->workers) {
+        fprintf(stderr, "Memory allocation failed for the pool workers\n");
+        return false;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->finish, NULL);
+    pool->task = NULL;
+    pool->arg = NULL;
+    pool->generation = 0;
+    pool->pending = 0;
+    pool->stop = false;
+    pool->threads = 1;
+    for (size_t i = 1; i < threads; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i;
+        if (pthread_create(&pool->workers[i].thread, NULL, forkJoinWorkerRun,
+                           &pool->workers[i]) != 0)
+            break;
+        pool->threads = i + 1;
+    }
+    return true;
+}
+
+// Stop and join the workers
+void forkJoinPoolFree(ForkJoinPool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    for (size_t i = 1; i < pool->threads; i++)
+        pthread_join(pool->workers[i].thread, NULL);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->finish);
+    free(pool->workers);
+    pool->workers = NULL;
+    pool->threads = 0;
+}
+
+// Run task(arg, worker, workers) on every participant and wait for all of
+// them. A NULL pool runs the task once on the caller.
+void forkJoinPoolRun(ForkJoinPool *pool, ForkJoinTask task, void *arg) {
+    if (!pool || pool->threads == 1) {
+        task(arg, 0, 1);
+        return;
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->arg = arg;
+    pool->pending = pool->threads - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    task(arg, 0, pool->threads);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0)
+        pthread_cond_wait(&pool->finish, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+// ---------------------------------------------------------------------------
+// Kernels
+//
+// Each kernel works on one contiguous slice. The scalar versions are the
+// reference; the AVX2 versions widen to int64 lanes so sums and running
+// totals cannot overflow, and are picked at startup when the CPU has AVX2.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    const char *name;
+    // Sum of n values
+    int64_t (*sum)(const int *data, size_t n);
+    // Smallest and largest of n > 0 values
+    void (*minMax)(const int *data, size_t n, int *min, int *max);
+    // Running totals starting from carry; return the total after the slice
+    int64_t (*scan)(const int *data, size_t n, int64_t carry, int64_t *out,
+                    bool exclusive);
+} ReductionKernels;
+
+static int64_t sumScalar(const int *data, size_t n) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < n; i++)
+        sum += data[i];
+    return sum;
+}
+
+static void minMaxScalar(const int *data, size_t n, int *min, int *max) {
+    int lo = data[0], hi = data[0];
+    for (size_t i = 1; i < n; i++) {
+        lo = data[i] < lo ? data[i] : lo;
+        hi = data[i] > hi ? data[i] : hi;
+    }
+    *min = lo;
+    *max = hi;
+}
+
+static int64_t scanScalar(const int *data, size_t n, int64_t carry,
+                          int64_t *out, bool exclusive) {
+    for (size_t i = 0; i < n; i++) {
+        int64_t next = carry + data[i];
+        out[i] = exclusive ? carry : next;
+        carry = next;
+    }
+    return carry;
+}
+
+#ifdef HAVE_X86_KERNELS
+__attribute__((target("avx2"))) static int64_t sumAvx2(const int *data,
+                                                       size_t n) {
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = acc0;
+    __m256i acc2 = acc0, acc3 = acc0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(data + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(data + i + 8));
+        acc0 = _mm256_add_epi64(
+            acc0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(a)));
+        acc1 = _mm256_add_epi64(
+            acc1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(a, 1)));
+        acc2 = _mm256_add_epi64(
+            acc2, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(b)));
+        acc3 = _mm256_add_epi64(
+            acc3, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(b, 1)));
+    }
+    __m256i acc = _mm256_add_epi64(_mm256_add_epi64(acc0, acc1),
+                                   _mm256_add_epi64(acc2, acc3));
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+           sumScalar(data + i, n - i);
+}
+
+__attribute__((target("avx2"))) static void
+minMaxAvx2(const int *data, size_t n, int *min, int *max) {
+    if (n < 16) {
+        minMaxScalar(data, n, min, max);
+        return;
+    }
+    __m256i lo0 = _mm256_loadu_si256((const __m256i *)data), hi0 = lo0;
+    __m256i lo1 = _mm256_loadu_si256((const __m256i *)(data + 8)), hi1 = lo1;
+    size_t i = 16;
+    for (; i + 16 <= n; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(data + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(data + i + 8));
+        lo0 = _mm256_min_epi32(lo0, a);
+        hi0 = _mm256_max_epi32(hi0, a);
+        lo1 = _mm256_min_epi32(lo1, b);
+        hi1 = _mm256_max_epi32(hi1, b);
+    }
+    int los[8], his[8];
+    _mm256_storeu_si256((__m256i *)los, _mm256_min_epi32(lo0, lo1));
+    _mm256_storeu_si256((__m256i *)his, _mm256_max_epi32(hi0, hi1));
+    int lo = los[0], hi = his[0];
+    for (int k = 1; k < 8; k++) {
+        lo = los[k] < lo ? los[k] : lo;
+        hi = his[k] > hi ? his[k] : hi;
+    }
+    for (; i < n; i++) {
+        lo = data[i] < lo ? data[i] : lo;
+        hi = data[i] > hi ? data[i] : hi;
+    }
+    *min = lo;
+    *max = hi;
+}
+
+// In-register inclusive scan of 4 int64 lanes: two shift-and-add steps
+__attribute__((target("avx2"))) static inline __m256i scanLanes(__m256i v) {
+    __m256i shifted = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 1, 0, 0));
+    v = _mm256_add_epi64(v, _mm256_blend_epi32(shifted,
+                                               _mm256_setzero_si256(), 0x03));
+    shifted = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 0, 0));
+    return _mm256_add_epi64(
+        v, _mm256_blend_epi32(shifted, _mm256_setzero_si256(), 0x0F));
+}
+
+__attribute__((target("avx2"))) static int64_t
+scanAvx2(const int *data, size_t n, int64_t carry, int64_t *out,
+         bool exclusive) {
+    __m256i total = _mm256_set1_epi64x(carry);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(data + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(data + i + 4));
+        __m256i va = _mm256_cvtepi32_epi64(a);
+        __m256i vb = _mm256_cvtepi32_epi64(b);
+        __m256i sa = _mm256_add_epi64(scanLanes(va), total);
+        total = _mm256_permute4x64_epi64(sa, _MM_SHUFFLE(3, 3, 3, 3));
+        __m256i sb = _mm256_add_epi64(scanLanes(vb), total);
+        total = _mm256_permute4x64_epi64(sb, _MM_SHUFFLE(3, 3, 3, 3));
+        if (exclusive) {
+            sa = _mm256_sub_epi64(sa, va);
+            sb = _mm256_sub_epi64(sb, vb);
+        }
+        _mm256_storeu_si256((__m256i *)(out + i), sa);
+        _mm256_storeu_si256((__m256i *)(out + i + 4), sb);
+    }
+    carry = _mm_cvtsi128_si64(_mm256_castsi256_si128(total));
+    return scanScalar(data + i, n - i, carry, out + i, exclusive);
+}
+#endif
+
+// Kernel sets from the most portable to the widest
+static const ReductionKernels reductionKernelTable[] = {
+    {"scalar", sumScalar, minMaxScalar, scanScalar},
+#ifdef HAVE_X86_KERNELS
+    {"avx2", sumAvx2, minMaxAvx2, scanAvx2},
+#endif
+};
+
+static const ReductionKernels *reductionKernels = &reductionKernelTable[0];
+
+// Select AVX2 kernels before main() runs when the CPU supports them
+__attribute__((constructor)) static void selectReductionKernels(void) {
+#ifdef HAVE_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        reductionKernels = &reductionKernelTable[1];
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Parallel drivers
+//
+// Every participant takes one contiguous slice. Slice boundaries fall on
+// 16-element (64-byte) multiples, so no two threads write the same cache
+// line of a scan output. Small arrays run on the caller alone: waking the
+// workers costs more than reading a few thousand elements.
+// ---------------------------------------------------------------------------
+
+#define MIN_ELEMENTS_PER_THREAD (64u << 10)
+#define MAX_REDUCTION_THREADS 64
+// Min/max are reduced per chunk so the index of the extreme value can be
+// found afterwards by rescanning a single chunk
+#define MIN_MAX_CHUNK 16384
+
+// Per-thread partial results, padded to separate cache lines
+typedef struct {
+    int64_t sum;
+    int min, max;
+    size_t minIndex, maxIndex;
+    uint64_t *bins;
+    char padding[24];
+} ReductionPartial;
+
+typedef struct {
+    const int *data;
+    size_t n;
+    ReductionPartial partials[MAX_REDUCTION_THREADS];
+    // Histogram bins cover [lo, lo + bins * binWidth)
+    int lo;
+    uint32_t binWidth;
+    size_t bins;
+    uint64_t binMagic; // 2^64 / binWidth rounded up; 0 for binWidth 1
+    // Scan output
+    int64_t *out;
+    bool exclusive;
+} ReductionJob;
+
+// Smallest and largest value with the index of their first occurrence
+typedef struct {
+    int min, max;
+    size_t minIndex, maxIndex;
+} IntegerMinMax;
+
+static size_t reductionWorkers(const ReductionJob *job, size_t workers) {
+    size_t useful = job->n / MIN_ELEMENTS_PER_THREAD;
+    if (useful < 1)
+        useful = 1;
+    if (workers > MAX_REDUCTION_THREADS)
+        workers = MAX_REDUCTION_THREADS;
+    return useful < workers ? useful : workers;
+}
+
+// Slice [begin, end) of worker `worker` out of `workers`. Return false for
+// participants beyond reductionWorkers(), which have no slice and no entry
+// in partials: pools may be larger than MAX_REDUCTION_THREADS.
+static bool reductionSlice(const ReductionJob *job, size_t worker,
+                           size_t workers, size_t *begin, size_t *end) {
+    workers = reductionWorkers(job, workers);
+    if (worker >= workers)
+        return false;
+    size_t per = (job->n / workers + 15) & ~(size_t)15;
+    *begin = per * worker < job->n ? per * worker : job->n;
+    *end = worker + 1 == workers || per * (worker + 1) > job->n
+               ? job->n
+               : per * (worker + 1);
+    return true;
+}
+
+static void sumTask(void *arg, size_t worker, size_t workers) {
+    ReductionJob *job = arg;
+    size_t begin, end;
+    if (!reductionSlice(job, worker, workers, &begin, &end))
+        return;
+    job->partials[worker].sum =
+        reductionKernels->sum(job->data + begin, end - begin);
+}
+
+static void minMaxTask(void *arg, size_t worker, size_t workers) {
+    ReductionJob *job = arg;
+    size_t begin, end;
+    if (!reductionSlice(job, worker, workers, &begin, &end) || begin == end)
+        return;
+    ReductionPartial *partial = &job->partials[worker];
+
+    // Remember the chunks holding the first minimum and the first maximum
+    size_t minChunk = begin, maxChunk = begin;
+    int lo, hi;
+    size_t len = end - begin < MIN_MAX_CHUNK ? end - begin : MIN_MAX_CHUNK;
+    reductionKernels->minMax(job->data + begin, len, &lo, &hi);
+    for (size_t c = begin + len; c < end; c += MIN_MAX_CHUNK) {
+        size_t count = end - c < MIN_MAX_CHUNK ? end - c : MIN_MAX_CHUNK;
+        int chunkLo, chunkHi;
+        reductionKernels->minMax(job->data + c, count, &chunkLo, &chunkHi);
+        if (chunkLo < lo) {
+            lo = chunkLo;
+            minChunk = c;
+        }
+        if (chunkHi > hi) {
+            hi = chunkHi;
+            maxChunk = c;
+        }
+    }
+    size_t i = minChunk;
+    while (job->data[i] != lo)
+        i++;
+    partial->minIndex = i;
+    for (i = maxChunk; job->data[i] != hi; i++)
+        ;
+    partial->maxIndex = i;
+    partial->min = lo;
+    partial->max = hi;
+}
+
+static void histogramTask(void *arg, size_t worker, size_t workers) {
+    ReductionJob *job = arg;
+    size_t begin, end;
+    if (!reductionSlice(job, worker, workers, &begin, &end))
+        return;
+    uint64_t *bins = job->partials[worker].bins;
+    uint64_t width = (uint64_t)job->binWidth * job->bins;
+    for (size_t i = begin; i < end; i++) {
+        uint64_t offset = (uint64_t)((int64_t)job->data[i] - job->lo);
+        if (offset >= width)
+            continue;
+        // offset / binWidth without a division (exact for 32-bit offsets,
+        // see Lemire et al., "Faster Remainder by Direct Computation").
+        // The magic for binWidth 1 would be 2^64 and is stored as 0.
+        if (job->binMagic == 0)
+            bins[offset]++;
+        else
+            bins[(size_t)(((unsigned __int128)job->binMagic * offset) >>
+                          64)]++;
+    }
+}
+
+static void scanTotalsTask(void *arg, size_t worker, size_t workers) {
+    sumTask(arg, worker, workers);
+}
+
+static void scanTask(void *arg, size_t worker, size_t workers) {
+    ReductionJob *job = arg;
+    size_t begin, end;
+    if (!reductionSlice(job, worker, workers, &begin, &end))
+        return;
+    // partials[worker].sum holds the total of all earlier slices
+    reductionKernels->scan(job->data + begin, end - begin,
+                           job->partials[worker].sum, job->out + begin,
+                           job->exclusive);
+}
+
+// Sum of all elements, accumulated in 64 bits. Exact for arrays of fewer
+// than 2^32 elements. `pool` may be NULL to run on the caller.
+int64_t sumIntegerDynamicArray(const IntegerDynamicArray *array,
+                               ForkJoinPool *pool) {
+    ReductionJob job = {.data = array->data, .n = array->size};
+    forkJoinPoolRun(pool, sumTask, &job);
+    int64_t sum = 0;
+    size_t workers = reductionWorkers(&job, pool ? pool->threads : 1);
+    for (size_t w = 0; w < workers; w++)
+        sum += job.partials[w].sum;
+    return sum;
+}
+
+// Smallest and largest element and the index of their first occurrence.
+// Return false if the array is empty.
+bool minMaxIntegerDynamicArray(const IntegerDynamicArray *array,
+                               ForkJoinPool *pool, IntegerMinMax *result) {
+    if (array->size == 0) {
+        fprintf(stderr, "Cannot take the min/max of an empty array\n");
+        return false;
+    }
+    ReductionJob job = {.data = array->data, .n = array->size};
+    forkJoinPoolRun(pool, minMaxTask, &job);
+    size_t workers = reductionWorkers(&job, pool ? pool->threads : 1);
+    const ReductionPartial *first = &job.partials[0];
+    *result = (IntegerMinMax){first->min, first->max, first->minIndex,
+                              first->maxIndex};
+    // Slices are in index order, so strict comparisons keep the first
+    // occurrence
+    for (size_t w = 1; w < workers; w++) {
+        const ReductionPartial *partial = &job.partials[w];
+        if (partial->min < result->min) {
+            result->min = partial->min;
+            result->minIndex = partial->minIndex;
+        }
+        if (partial->max > result->max) {
+            result->max = partial->max;
+            result->maxIndex = partial->maxIndex;
+        }
+    }
+    return true;
+}
+
+// Count the elements in each of `bins` bins of `binWidth` values starting
+// at `lo`; bin b counts [lo + b * binWidth, lo + (b + 1) * binWidth).
+// Elements outside all bins are ignored. Every thread fills private bins,
+// which are added up at the end.
+bool histogramIntegerDynamicArray(const IntegerDynamicArray *array,
+                                  ForkJoinPool *pool, int lo,
+                                  uint32_t binWidth, size_t bins,
+                                  uint64_t *counts) {
+    if (binWidth == 0 || bins == 0) {
+        fprintf(stderr, "A histogram needs at least one non-empty bin\n");
+        return false;
+    }
+    ReductionJob job = {.data = array->data,
+                        .n = array->size,
+                        .lo = lo,
+                        .binWidth = binWidth,
+                        .bins = bins,
+                        .binMagic = binWidth == 1
+                                        ? 0
+                                        : UINT64_MAX / binWidth + 1};
+    size_t workers = reductionWorkers(&job, pool ? pool->threads : 1);
+    // One private row per worker; worker 0 writes straight into counts
+    uint64_t *rows = NULL;
+    if (workers > 1) {
+        rows = calloc((workers - 1) * bins, sizeof(uint64_t));
+        if (!rows) {
+            fprintf(stderr, "Memory allocation failed for histogram bins\n");
+            return false;
+        }
+    }
+    memset(counts, 0, bins * sizeof(uint64_t));
+    job.partials[0].bins = counts;
+    for (size_t w = 1; w < workers; w++)
+        job.partials[w].bins = rows + (w - 1) * bins;
+    forkJoinPoolRun(pool, histogramTask, &job);
+    for (size_t w = 1; w < workers; w++) {
+        for (size_t b = 0; b < bins; b++)
+            counts[b] += job.partials[w].bins[b];
+    }
+    free(rows);
+    return true;
+}
+
+// Running totals of the array into out (array->size values). The
+// parallel version reads the array twice: once for the slice totals, once
+// to write each slice's running totals from its starting offset.
+static void scanIntegerDynamicArray(const IntegerDynamicArray *array,
+                                    ForkJoinPool *pool, int64_t *out,
+                                    bool exclusive) {
+    ReductionJob job = {.data = array->data,
+                        .n = array->size,
+                        .out = out,
+                        .exclusive = exclusive};
+    size_t workers = reductionWorkers(&job, pool ? pool->threads : 1);
+    if (workers == 1) {
+        reductionKernels->scan(job.data, job.n, 0, out, exclusive);
+        return;
+    }
+    forkJoinPoolRun(pool, scanTotalsTask, &job);
+    int64_t offset = 0;
+    for (size_t w = 0; w < workers; w++) {
+        int64_t total = job.partials[w].sum;
+        job.partials[w].sum = offset;
+        offset += total;
+    }
+    forkJoinPoolRun(pool, scanTask, &job);
+}
+
+// out[i] = array[0] + ... + array[i]
+void inclusiveScanIntegerDynamicArray(const IntegerDynamicArray *array,
+                                      ForkJoinPool *pool, int64_t *out) {
+    scanIntegerDynamicArray(array, pool, out, false);
+}
+
+// out[i] = array[0] + ... + array[i - 1], out[0] = 0
+void exclusiveScanIntegerDynamicArray(const IntegerDynamicArray *array,
+                                      ForkJoinPool *pool, int64_t *out) {
+    scanIntegerDynamicArray(array, pool, out, true);
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Time every reduction with the scalar kernels on one thread, then with the
+// selected kernels on `threads` threads, and check that both agree
+static void benchmark(size_t n, size_t threads) {
+    IntegerDynamicArray vec = {malloc(n * sizeof(int)), n, n};
+    int64_t *scan = malloc(n * sizeof(int64_t));
+    if (!vec.data || !scan) {
+        free(vec.data);
+        free(scan);
+        return;
+    }
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < n; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        vec.data[i] = (int)state;
+    }
+
+    ForkJoinPool pool;
+    if (!forkJoinPoolInitialize(&pool, threads)) {
+        free(vec.data);
+        free(scan);
+        return;
+    }
+    const ReductionKernels *selected = reductionKernels;
+    double gb = (double)(n * sizeof(int)) / 1e9;
+    enum { BINS = 256 };
+    uint64_t counts[2][BINS];
+    int64_t sums[2], lastScan[2];
+    IntegerMinMax minMax[2];
+    for (int run = 0; run < 2; run++) {
+        reductionKernels = run == 0 ? &reductionKernelTable[0] : selected;
+        ForkJoinPool *p = run == 0 ? NULL : &pool;
+        printf("%-6s %2zu thread(s):", reductionKernels->name,
+               run == 0 ? (size_t)1 : pool.threads);
+
+        double start = nowSeconds();
+        sums[run] = sumIntegerDynamicArray(&vec, p);
+        printf(" sum %5.2f GB/s,", gb / (nowSeconds() - start));
+
+        start = nowSeconds();
+        minMaxIntegerDynamicArray(&vec, p, &minMax[run]);
+        printf(" min/max %5.2f GB/s,", gb / (nowSeconds() - start));
+
+        start = nowSeconds();
+        histogramIntegerDynamicArray(&vec, p, INT32_MIN, 1u << 24, BINS,
+                                     counts[run]);
+        printf(" histogram %5.2f GB/s,", gb / (nowSeconds() - start));
+
+        start = nowSeconds();
+        inclusiveScanIntegerDynamicArray(&vec, p, scan);
+        // Reads n ints, writes n int64s
+        printf(" scan %5.2f GB/s\n", 3 * gb / (nowSeconds() - start));
+        lastScan[run] = scan[n - 1];
+    }
+    reductionKernels = selected;
+
+    bool agree = sums[0] == sums[1] && lastScan[0] == sums[0] &&
+                 memcmp(&minMax[0], &minMax[1], sizeof(IntegerMinMax)) == 0 &&
+                 memcmp(counts[0], counts[1], sizeof(counts[0])) == 0;
+    printf("sum %ld, min %d at %zu, max %d at %zu: %s\n", sums[1],
+           minMax[1].min, minMax[1].minIndex, minMax[1].max,
+           minMax[1].maxIndex, agree ? "results agree" : "MISMATCH");
+    forkJoinPoolFree(&pool);
+    free(vec.data);
+    free(scan);
+}
+
+int main(void) {
+    int values[] = {5, -3, 12, 7, -3, 12, 0, 9, -1, 4};
+    size_t count = sizeof(values) / sizeof(*values);
+    IntegerDynamicArray vec = {values, count, count};
+
+    IntegerMinMax minMax;
+    minMaxIntegerDynamicArray(&vec, NULL, &minMax);
+    printf("Sum %ld, min %d at %zu, max %d at %zu\n",
+           sumIntegerDynamicArray(&vec, NULL), minMax.min, minMax.minIndex,
+           minMax.max, minMax.maxIndex);
+
+    int64_t inclusive[sizeof(values) / sizeof(*values)];
+    int64_t exclusive[sizeof(values) / sizeof(*values)];
+    inclusiveScanIntegerDynamicArray(&vec, NULL, inclusive);
+    exclusiveScanIntegerDynamicArray(&vec, NULL, exclusive);
+    printf("Inclusive scan:");
+    for (size_t i = 0; i < count; i++)
+        printf(" %ld", inclusive[i]);
+    printf("\nExclusive scan:");
+    for (size_t i = 0; i < count; i++)
+        printf(" %ld", exclusive[i]);
+
+    uint64_t bins[4];
+    histogramIntegerDynamicArray(&vec, NULL, -4, 4, 4, bins);
+    printf("\nHistogram of [-4, 12) in bins of 4:");
+    for (size_t b = 0; b < 4; b++)
+        printf(" %lu", bins[b]);
+    int small[] = {0, 1, 2, 3, 3, 3};
+    IntegerDynamicArray smallVec = {small, 6, 6};
+    histogramIntegerDynamicArray(&smallVec, NULL, 0, 1, 4, bins);
+    printf("\nHistogram of {0, 1, 2, 3, 3, 3} in bins of 1:");
+    for (size_t b = 0; b < 4; b++)
+        printf(" %lu", bins[b]);
+    printf("\n\n");
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t threads = cpus > 1 ? (size_t)cpus : 4;
+    benchmark(1u << 20, threads);
+    benchmark(256u << 20, threads);
+    return EXIT_SUCCESS;
+}
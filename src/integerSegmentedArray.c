@@ -0,0 +1,365 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Structure to hold the dynamic integer array (as in integerDynamicArray.c)
+typedef struct {
+    int *data;       // Pointer to the array holding the data
+    size_t size;     // Current number of elements in the array
+    size_t capacity; // Current capacity of the array (adjustable)
+} IntegerDynamicArray;
+
+// ---------------------------------------------------------------------------
+// Segmented array
+//
+// Elements live in a fixed directory of chunks whose sizes double: chunk k
+// holds SEGMENT_FIRST << k elements, so chunks 0 .. k - 1 hold
+// SEGMENT_FIRST * (2^k - 1) together. Growing allocates the next chunk and
+// never moves an element, so pointers into the array stay valid until it
+// is freed, and no append pays for copying what came before. Index i is
+// found with one count-leading-zeros: with j = i + SEGMENT_FIRST, the chunk
+// is log2(j) - SEGMENT_FIRST_BITS and the offset is j minus the chunk's
+// first index.
+// ---------------------------------------------------------------------------
+
+#define SEGMENT_FIRST_BITS 10
+#define SEGMENT_FIRST ((size_t)1 << SEGMENT_FIRST_BITS)
+// Enough chunks for any index a size_t can hold
+#define SEGMENT_MAX_CHUNKS (64 - SEGMENT_FIRST_BITS)
+
+typedef struct {
+    int *chunks[SEGMENT_MAX_CHUNKS]; // Chunk k holds SEGMENT_FIRST << k
+    size_t chunkCount;               // Chunks allocated so far
+    size_t size;                     // Current number of elements
+    size_t capacity;                 // Elements in all allocated chunks
+    int *next;                       // Slot of the next append
+    int *end;                        // End of the chunk holding `next`
+} IntegerSegmentedArray;
+
+static inline size_t segmentChunk(size_t index) {
+    return (size_t)(63 - __builtin_clzll(index + SEGMENT_FIRST)) -
+           SEGMENT_FIRST_BITS;
+}
+
+static inline size_t segmentOffset(size_t index, size_t chunk) {
+    return index + SEGMENT_FIRST - (SEGMENT_FIRST << chunk);
+}
+
+// Initialize an empty segmented array; no chunk is allocated until the
+// first append
+void initializeIntegerSegmentedArray(IntegerSegmentedArray *array) {
+    memset(array, 0, sizeof(*array));
+}
+
+// Free every chunk of the segmented array
+void freeIntegerSegmentedArray(IntegerSegmentedArray *array) {
+    for (size_t k = 0; k < array->chunkCount; k++)
+        free(array->chunks[k]);
+    initializeIntegerSegmentedArray(array);
+}
+
+// Allocate the next chunk
+static bool addChunkIntegerSegmentedArray(IntegerSegmentedArray *array) {
+    size_t k = array->chunkCount;
+    if (k == SEGMENT_MAX_CHUNKS) {
+        fprintf(stderr, "Segmented array directory is full\n");
+        return false;
+    }
+    size_t bytes = (SEGMENT_FIRST << k) * sizeof(int);
+    int *chunk = aligned_alloc(64, bytes);
+    if (chunk == NULL) {
+        fprintf(stderr, "Memory allocation failed for chunk %zu\n", k);
+        return false;
+    }
+    array->chunks[k] = chunk;
+    array->chunkCount++;
+    array->capacity += SEGMENT_FIRST << k;
+    return true;
+}
+
+// Allocate chunks until the array can hold `capacity` elements
+bool reserveIntegerSegmentedArray(IntegerSegmentedArray *array,
+                                  size_t capacity) {
+    while (array->capacity < capacity) {
+        if (!addChunkIntegerSegmentedArray(array))
+            return false;
+    }
+    return true;
+}
+
+// Point next/end at the slot for index array->size
+static void seekTailIntegerSegmentedArray(IntegerSegmentedArray *array) {
+    size_t k = segmentChunk(array->size);
+    array->next = array->chunks[k] + segmentOffset(array->size, k);
+    array->end = array->chunks[k] + (SEGMENT_FIRST << k);
+}
+
+// Append a value to the end of the segmented array
+bool appendIntegerSegmentedArray(IntegerSegmentedArray *array, int value) {
+    if (array->next == array->end) {
+        // The current chunk is full: move on to the next one
+        if (array->size == array->capacity &&
+            !addChunkIntegerSegmentedArray(array))
+            return false;
+        seekTailIntegerSegmentedArray(array);
+    }
+    *array->next++ = value;
+    array->size++;
+    return true;
+}
+
+// Address of the element at `index`, stable for the life of the array, or
+// NULL if the index is out of range
+int *atIntegerSegmentedArray(IntegerSegmentedArray *array, size_t index) {
+    if (index >= array->size) {
+        fprintf(stderr, "Index %zu out of range (size %zu)\n", index,
+                array->size);
+        return NULL;
+    }
+    size_t k = segmentChunk(index);
+    return &array->chunks[k][segmentOffset(index, k)];
+}
+
+// Remove the last element; its chunk is kept for later appends
+bool popIntegerSegmentedArray(IntegerSegmentedArray *array, int *value) {
+    if (array->size == 0) {
+        fprintf(stderr, "Cannot pop from an empty segmented array\n");
+        return false;
+    }
+    size_t k = segmentChunk(array->size - 1);
+    *value = array->chunks[k][segmentOffset(array->size - 1, k)];
+    array->size--;
+    seekTailIntegerSegmentedArray(array);
+    return true;
+}
+
+// Callback for chunk-wise iteration: `count` contiguous elements starting
+// at `data`, which hold indices firstIndex .. firstIndex + count - 1
+typedef void (*SegmentVisitor)(int *data, size_t count, size_t firstIndex,
+                               void *context);
+
+// Visit the elements chunk by chunk, in index order
+void forEachChunkIntegerSegmentedArray(IntegerSegmentedArray *array,
+                                       SegmentVisitor visit, void *context) {
+    size_t first = 0;
+    for (size_t k = 0; first < array->size; k++) {
+        size_t count = SEGMENT_FIRST << k;
+        if (count > array->size - first)
+            count = array->size - first;
+        visit(array->chunks[k], count, first, context);
+        first += count;
+    }
+}
+
+// Parallel iteration splits the elements into pieces of SEGMENT_PIECE
+// elements: piece 0 is all the chunks smaller than a piece, and chunk k >=
+// SEGMENT_SMALL_CHUNKS is pieces 2^(k - SEGMENT_SMALL_CHUNKS) up to twice
+// that, so a piece number maps to its chunk with the same bit math as an
+// index. Threads claim pieces from a shared counter, so the large late
+// chunks are shared out like the small early ones.
+#define SEGMENT_PIECE_BITS 16
+#define SEGMENT_PIECE ((size_t)1 << SEGMENT_PIECE_BITS)
+#define SEGMENT_SMALL_CHUNKS (SEGMENT_PIECE_BITS - SEGMENT_FIRST_BITS)
+
+typedef struct {
+    IntegerSegmentedArray *array;
+    SegmentVisitor visit;
+    void *context;
+    atomic_size_t nextPiece;
+} SegmentIteration;
+
+static void *segmentIterationRun(void *arg) {
+    SegmentIteration *it = arg;
+    IntegerSegmentedArray *array = it->array;
+    for (;;) {
+        size_t piece = atomic_fetch_add(&it->nextPiece, 1);
+        if (piece == 0) {
+            // The small chunks, one visit each
+            size_t first = 0;
+            for (size_t k = 0; k < SEGMENT_SMALL_CHUNKS && first < array->size;
+                 k++) {
+                size_t count = SEGMENT_FIRST << k;
+                if (count > array->size - first)
+                    count = array->size - first;
+                it->visit(array->chunks[k], count, first, it->context);
+                first += count;
+            }
+            continue;
+        }
+        size_t log = (size_t)(63 - __builtin_clzll(piece));
+        size_t k = SEGMENT_SMALL_CHUNKS + log;
+        size_t offset = (piece - ((size_t)1 << log)) * SEGMENT_PIECE;
+        size_t first = (SEGMENT_FIRST << k) - SEGMENT_FIRST + offset;
+        if (first >= array->size)
+            break;
+        size_t count = SEGMENT_PIECE;
+        if (count > array->size - first)
+            count = array->size - first;
+        it->visit(array->chunks[k] + offset, count, first, it->context);
+    }
+    return NULL;
+}
+
+// Visit the elements chunk-wise on `threads` threads. Pieces are visited
+// concurrently and in no particular order; `visit` must be thread-safe.
+bool parallelForEachChunkIntegerSegmentedArray(IntegerSegmentedArray *array,
+                                               size_t threads,
+                                               SegmentVisitor visit,
+                                               void *context) {
+    SegmentIteration it = {array, visit, context, 0};
+    if (threads < 2) {
+        forEachChunkIntegerSegmentedArray(array, visit, context);
+        return true;
+    }
+    pthread_t *ids = malloc((threads - 1) * sizeof(pthread_t));
+    if (!ids) {
+        fprintf(stderr, "Memory allocation failed for iteration threads\n");
+        return false;
+    }
+    size_t started = 0;
+    for (; started < threads - 1; started++) {
+        if (pthread_create(&ids[started], NULL, segmentIterationRun, &it) !=
+            0)
+            break;
+    }
+    // The caller takes pieces too, and covers for threads that failed
+    segmentIterationRun(&it);
+    for (size_t t = 0; t < started; t++)
+        pthread_join(ids[t], NULL);
+    free(ids);
+    return true;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void sumVisitor(int *data, size_t count, size_t firstIndex,
+                       void *context) {
+    (void)firstIndex;
+    int64_t sum = 0;
+    for (size_t i = 0; i < count; i++)
+        sum += data[i];
+    atomic_fetch_add((_Atomic int64_t *)context, sum);
+}
+
+// Append latencies are kept in a log2 histogram of nanoseconds
+#define LATENCY_BUCKETS 40
+
+typedef struct {
+    uint64_t buckets[LATENCY_BUCKETS];
+    uint64_t count;
+    uint64_t maxNs;
+} LatencyHistogram;
+
+static inline uint64_t nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void recordLatency(LatencyHistogram *h, uint64_t ns) {
+    size_t bucket = ns ? (size_t)(64 - __builtin_clzll(ns)) : 0;
+    h->buckets[bucket < LATENCY_BUCKETS ? bucket : LATENCY_BUCKETS - 1]++;
+    h->count++;
+    h->maxNs = ns > h->maxNs ? ns : h->maxNs;
+}
+
+// Upper bound of the bucket holding quantile q
+static uint64_t latencyQuantile(const LatencyHistogram *h, double q) {
+    uint64_t rank = (uint64_t)(q * (double)h->count), seen = 0;
+    for (size_t b = 0; b < LATENCY_BUCKETS; b++) {
+        seen += h->buckets[b];
+        if (seen > rank)
+            return b ? (uint64_t)1 << b : 1;
+    }
+    return h->maxNs;
+}
+
+static void printLatency(const char *label, const LatencyHistogram *h,
+                         double seconds) {
+    printf("%-18s %6.2f s, p50 <= %3lu ns, p99.99 <= %6lu ns, "
+           "max %9.3f ms\n",
+           label, seconds, latencyQuantile(h, 0.5),
+           latencyQuantile(h, 0.9999), (double)h->maxNs / 1e6);
+}
+
+// Time every one of n appends to the realloc-based array and to the
+// segmented array
+static void benchmarkAppendLatency(size_t n) {
+    static LatencyHistogram flat, segmented;
+    memset(&flat, 0, sizeof(flat));
+    memset(&segmented, 0, sizeof(segmented));
+
+    // appendIntegerDynamicArray: double and realloc when full
+    IntegerDynamicArray vec = {malloc(4 * sizeof(int)), 0, 4};
+    double start = nowSeconds();
+    for (size_t i = 0; i < n && vec.data; i++) {
+        uint64_t t0 = nowNs();
+        if (vec.size == vec.capacity) {
+            int *newData = realloc(vec.data, 2 * vec.capacity * sizeof(int));
+            if (!newData)
+                break;
+            vec.data = newData;
+            vec.capacity *= 2;
+        }
+        vec.data[vec.size++] = (int)i;
+        recordLatency(&flat, nowNs() - t0);
+    }
+    printLatency("realloc array", &flat, nowSeconds() - start);
+    free(vec.data);
+
+    IntegerSegmentedArray array;
+    initializeIntegerSegmentedArray(&array);
+    start = nowSeconds();
+    for (size_t i = 0; i < n; i++) {
+        uint64_t t0 = nowNs();
+        appendIntegerSegmentedArray(&array, (int)i);
+        recordLatency(&segmented, nowNs() - t0);
+    }
+    printLatency("segmented array", &segmented, nowSeconds() - start);
+    freeIntegerSegmentedArray(&array);
+}
+
+int main(void) {
+    IntegerSegmentedArray array;
+    initializeIntegerSegmentedArray(&array);
+    for (int i = 0; i < 5000; i++)
+        appendIntegerSegmentedArray(&array, i);
+    int *pinned = atIntegerSegmentedArray(&array, 1234);
+    printf("Pinned element 1234 = %d at %p\n", *pinned, (void *)pinned);
+
+    // Grow to 16M elements: the pinned element does not move
+    for (int i = 5000; i < (16 << 20); i++)
+        appendIntegerSegmentedArray(&array, i);
+    printf("After growing to %zu elements in %zu chunks: %d at %p (%s)\n",
+           array.size, array.chunkCount, *pinned, (void *)pinned,
+           pinned == atIntegerSegmentedArray(&array, 1234) ? "same address"
+                                                           : "MOVED");
+
+    int64_t expected = (int64_t)array.size * ((int64_t)array.size - 1) / 2;
+    _Atomic int64_t sum = 0;
+    double start = nowSeconds();
+    forEachChunkIntegerSegmentedArray(&array, sumVisitor, &sum);
+    double sequential = nowSeconds() - start;
+    bool ok = atomic_load(&sum) == expected;
+    atomic_store(&sum, 0);
+    start = nowSeconds();
+    parallelForEachChunkIntegerSegmentedArray(&array, 4, sumVisitor, &sum);
+    double parallel = nowSeconds() - start;
+    ok &= atomic_load(&sum) == expected;
+    printf("Chunk-wise sum: %.1f ms, 4 threads %.1f ms (%s)\n",
+           sequential * 1e3, parallel * 1e3, ok ? "correct" : "WRONG");
+    freeIntegerSegmentedArray(&array);
+
+    printf("\nLatency of 64M appends:\n");
+    benchmarkAppendLatency(64u << 20);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,474 @@
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Structure to hold the dynamic integer array (as in integerDynamicArray.c)
+typedef struct {
+    int *data;       // Pointer to the array holding the data
+    size_t size;     // Current number of elements in the array
+    size_t capacity; // Current capacity of the array (adjustable)
+} IntegerDynamicArray;
+
+// ---------------------------------------------------------------------------
+// LSD radix sort
+//
+// Keys are mapped to unsigned integers with the same order by flipping the
+// sign bit, then sorted one byte at a time from the least significant byte.
+// All byte histograms are gathered in a single read pass up front, and a pass
+// whose digit is the same for every key (one bucket holding all n keys) is
+// skipped: small-range or shared-prefix data sorts in fewer passes.
+// ---------------------------------------------------------------------------
+
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+
+// Sort 32-bit unsigned keys; `tmp` holds n keys of scratch.
+// Return the buffer (keys or tmp) that holds the sorted result.
+static uint32_t *radixSort32(uint32_t *keys, uint32_t *tmp, size_t n) {
+    size_t counts[4][RADIX_BUCKETS] = {{0}};
+    for (size_t i = 0; i < n; i++) {
+        uint32_t k = keys[i];
+        counts[0][k & 0xFF]++;
+        counts[1][k >> 8 & 0xFF]++;
+        counts[2][k >> 16 & 0xFF]++;
+        counts[3][k >> 24]++;
+    }
+
+    for (int digit = 0; digit < 4; digit++) {
+        int shift = digit * RADIX_BITS;
+        if (n == 0 || counts[digit][keys[0] >> shift & 0xFF] == n)
+            continue; // every key has the same digit
+        size_t offsets[RADIX_BUCKETS], sum = 0;
+        for (int b = 0; b < RADIX_BUCKETS; b++) {
+            offsets[b] = sum;
+            sum += counts[digit][b];
+        }
+        for (size_t i = 0; i < n; i++)
+            tmp[offsets[keys[i] >> shift & 0xFF]++] = keys[i];
+        uint32_t *t = keys;
+        keys = tmp;
+        tmp = t;
+    }
+    return keys;
+}
+
+// Sort `digits` low bytes of 64-bit unsigned keys, carrying an optional
+// payload (NULL for none); the tmp buffers hold n entries of scratch.
+// Return the buffer (keys or keyTmp) that holds the sorted keys; the sorted
+// payload is in the matching buffer.
+static uint64_t *radixSort64(uint64_t *keys, uint64_t *payload,
+                             uint64_t *keyTmp, uint64_t *payloadTmp, size_t n,
+                             int digits) {
+    size_t counts[8][RADIX_BUCKETS] = {{0}};
+    for (size_t i = 0; i < n; i++) {
+        uint64_t k = keys[i];
+        for (int digit = 0; digit < digits; digit++)
+            counts[digit][k >> (digit * RADIX_BITS) & 0xFF]++;
+    }
+
+    for (int digit = 0; digit < digits; digit++) {
+        int shift = digit * RADIX_BITS;
+        if (n == 0 || counts[digit][keys[0] >> shift & 0xFF] == n)
+            continue; // every key has the same digit
+        size_t offsets[RADIX_BUCKETS], sum = 0;
+        for (int b = 0; b < RADIX_BUCKETS; b++) {
+            offsets[b] = sum;
+            sum += counts[digit][b];
+        }
+        if (payload) {
+            for (size_t i = 0; i < n; i++) {
+                size_t to = offsets[keys[i] >> shift & 0xFF]++;
+                keyTmp[to] = keys[i];
+                payloadTmp[to] = payload[i];
+            }
+            uint64_t *t = payload;
+            payload = payloadTmp;
+            payloadTmp = t;
+        } else {
+            for (size_t i = 0; i < n; i++)
+                keyTmp[offsets[keys[i] >> shift & 0xFF]++] = keys[i];
+        }
+        uint64_t *t = keys;
+        keys = keyTmp;
+        keyTmp = t;
+    }
+    return keys;
+}
+
+// Sort an int array in ascending order.
+// Return false if the scratch buffer cannot be allocated.
+bool integerRadixSort(int *data, size_t n) {
+    uint32_t *tmp = malloc(n * sizeof(uint32_t));
+    if (!tmp && n > 0) {
+        fprintf(stderr, "Memory allocation failed for radix sort buffer\n");
+        return false;
+    }
+    uint32_t *keys = (uint32_t *)data;
+    for (size_t i = 0; i < n; i++)
+        keys[i] ^= 0x80000000u;
+    uint32_t *sorted = radixSort32(keys, tmp, n);
+    for (size_t i = 0; i < n; i++)
+        keys[i] = sorted[i] ^ 0x80000000u;
+    free(tmp);
+    return true;
+}
+
+// Sort an int64_t array in ascending order using `tmp` (n values) as
+// scratch. The sorted values end up in data.
+static void int64RadixSortBuffer(int64_t *data, int64_t *tmp, size_t n) {
+    uint64_t *keys = (uint64_t *)data;
+    for (size_t i = 0; i < n; i++)
+        keys[i] ^= 1ULL << 63;
+    uint64_t *sorted = radixSort64(keys, NULL, (uint64_t *)tmp, NULL, n, 8);
+    for (size_t i = 0; i < n; i++)
+        keys[i] = sorted[i] ^ 1ULL << 63;
+}
+
+// Sort an int64_t array in ascending order.
+// Return false if the scratch buffer cannot be allocated.
+bool int64RadixSort(int64_t *data, size_t n) {
+    int64_t *tmp = malloc(n * sizeof(int64_t));
+    if (!tmp && n > 0) {
+        fprintf(stderr, "Memory allocation failed for radix sort buffer\n");
+        return false;
+    }
+    int64RadixSortBuffer(data, tmp, n);
+    free(tmp);
+    return true;
+}
+
+// Sort int64_t keys in ascending order, applying the same reordering to a
+// parallel payload array (e.g. record ids or pointers cast to uint64_t).
+// The sort is stable. Return false if scratch buffers cannot be allocated.
+bool int64RadixSortWithPayload(int64_t *keys, uint64_t *payload, size_t n) {
+    uint64_t *keyTmp = malloc(n * sizeof(uint64_t));
+    uint64_t *payloadTmp = malloc(n * sizeof(uint64_t));
+    if ((!keyTmp || !payloadTmp) && n > 0) {
+        fprintf(stderr, "Memory allocation failed for radix sort buffers\n");
+        free(keyTmp);
+        free(payloadTmp);
+        return false;
+    }
+    uint64_t *k = (uint64_t *)keys;
+    for (size_t i = 0; i < n; i++)
+        k[i] ^= 1ULL << 63;
+    uint64_t *sorted = radixSort64(k, payload, keyTmp, payloadTmp, n, 8);
+    if (sorted != k)
+        memcpy(payload, payloadTmp, n * sizeof(uint64_t));
+    for (size_t i = 0; i < n; i++)
+        k[i] = sorted[i] ^ 1ULL << 63;
+    free(keyTmp);
+    free(payloadTmp);
+    return true;
+}
+
+// Compute the stable sorting permutation of int keys without moving them:
+// afterwards keys[permutation[0]] <= keys[permutation[1]] <= ...
+// Return false if scratch buffers cannot be allocated.
+bool integerSortPermutation(const int *keys, size_t n, size_t *permutation) {
+    uint64_t *k = malloc(n * sizeof(uint64_t));
+    uint64_t *kTmp = malloc(n * sizeof(uint64_t));
+    uint64_t *pTmp = malloc(n * sizeof(uint64_t));
+    if ((!k || !kTmp || !pTmp) && n > 0) {
+        fprintf(stderr, "Memory allocation failed for permutation sort\n");
+        free(k);
+        free(kTmp);
+        free(pTmp);
+        return false;
+    }
+    // size_t and uint64_t share a representation on the platforms we target
+    uint64_t *p = (uint64_t *)permutation;
+    for (size_t i = 0; i < n; i++) {
+        k[i] = (uint32_t)keys[i] ^ 0x80000000u;
+        p[i] = i;
+    }
+    if (radixSort64(k, p, kTmp, pTmp, n, 4) != k)
+        memcpy(p, pTmp, n * sizeof(uint64_t));
+    free(k);
+    free(kTmp);
+    free(pTmp);
+    return true;
+}
+
+// Sort the contents of an IntegerDynamicArray in ascending order
+bool sortIntegerDynamicArray(IntegerDynamicArray *array) {
+    return integerRadixSort(array->data, array->size);
+}
+
+// ---------------------------------------------------------------------------
+// Parallel sample sort
+//
+// A random sample picks threads-1 splitters. Every thread classifies its
+// slice of the input against the splitters and counts per bucket; after a
+// prefix sum over (bucket, thread) each thread scatters its slice straight to
+// its private ranges of the scratch buffer. Each bucket is then radix sorted
+// independently, by one thread, back into its final place in the input.
+// ---------------------------------------------------------------------------
+
+// Elements drawn per splitter when sampling
+#define SAMPLE_OVERSAMPLING 64
+// Below this many elements per thread the sequential radix sort is used
+#define SAMPLE_SORT_MIN_PER_THREAD (1u << 16)
+
+typedef struct {
+    int64_t *data;
+    int64_t *tmp;
+    size_t n;
+    size_t threads;
+    const int64_t *splitters; // threads - 1 values
+    size_t *counts;           // counts[t * threads + b]
+    size_t *offsets;          // scatter offset of thread t into bucket b
+    size_t *bucketStart;      // threads + 1 boundaries in tmp
+} SampleSortShared;
+
+typedef struct {
+    SampleSortShared *shared;
+    size_t id;
+} SampleSortTask;
+
+// Bucket of a value: the number of splitters <= value
+static inline size_t sampleBucket(const int64_t *splitters, size_t count,
+                                  int64_t value) {
+    size_t lo = 0;
+    while (count > 0) {
+        size_t half = count / 2;
+        if (splitters[lo + half] <= value) {
+            lo += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    return lo;
+}
+
+static inline void sliceBounds(const SampleSortShared *s, size_t id,
+                               size_t *begin, size_t *end) {
+    *begin = s->n * id / s->threads;
+    *end = s->n * (id + 1) / s->threads;
+}
+
+static void *sampleSortCount(void *arg) {
+    SampleSortTask *task = arg;
+    SampleSortShared *s = task->shared;
+    size_t begin, end;
+    sliceBounds(s, task->id, &begin, &end);
+    size_t *counts = &s->counts[task->id * s->threads];
+    for (size_t i = begin; i < end; i++)
+        counts[sampleBucket(s->splitters, s->threads - 1, s->data[i])]++;
+    return NULL;
+}
+
+static void *sampleSortScatter(void *arg) {
+    SampleSortTask *task = arg;
+    SampleSortShared *s = task->shared;
+    size_t begin, end;
+    sliceBounds(s, task->id, &begin, &end);
+    size_t *offsets = &s->offsets[task->id * s->threads];
+    for (size_t i = begin; i < end; i++) {
+        int64_t v = s->data[i];
+        s->tmp[offsets[sampleBucket(s->splitters, s->threads - 1, v)]++] = v;
+    }
+    return NULL;
+}
+
+static void *sampleSortBucket(void *arg) {
+    SampleSortTask *task = arg;
+    SampleSortShared *s = task->shared;
+    size_t begin = s->bucketStart[task->id];
+    size_t count = s->bucketStart[task->id + 1] - begin;
+    // Move the bucket to its final range and sort it there, with its range
+    // of the scratch buffer as radix scratch
+    memcpy(s->data + begin, s->tmp + begin, count * sizeof(int64_t));
+    int64RadixSortBuffer(s->data + begin, s->tmp + begin, count);
+    return NULL;
+}
+
+// Run one phase on every thread and wait for all of them
+static bool runPhase(SampleSortTask *tasks, size_t threads,
+                     void *(*phase)(void *)) {
+    pthread_t *ids = malloc(threads * sizeof(pthread_t));
+    if (!ids)
+        return false;
+    size_t started = 0;
+    for (; started < threads; started++) {
+        if (pthread_create(&ids[started], NULL, phase, &tasks[started]) != 0)
+            break;
+    }
+    // Threads that could not be started run on the caller
+    for (size_t t = started; t < threads; t++)
+        phase(&tasks[t]);
+    for (size_t t = 0; t < started; t++)
+        pthread_join(ids[t], NULL);
+    free(ids);
+    return true;
+}
+
+static int compareInt64(const void *a, const void *b) {
+    int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Sort an int64_t array in ascending order with `threads` threads.
+// Return false if buffers cannot be allocated.
+bool int64ParallelSampleSort(int64_t *data, size_t n, size_t threads) {
+    if (threads < 2 || n < threads * SAMPLE_SORT_MIN_PER_THREAD)
+        return int64RadixSort(data, n);
+
+    size_t sampleSize = threads * SAMPLE_OVERSAMPLING;
+    int64_t *sample = malloc(sampleSize * sizeof(int64_t));
+    int64_t *splitters = malloc((threads - 1) * sizeof(int64_t));
+    int64_t *tmp = malloc(n * sizeof(int64_t));
+    size_t *counts = calloc(threads * threads, sizeof(size_t));
+    size_t *offsets = malloc(threads * threads * sizeof(size_t));
+    size_t *bucketStart = malloc((threads + 1) * sizeof(size_t));
+    SampleSortTask *tasks = malloc(threads * sizeof(SampleSortTask));
+    bool ok = sample && splitters && tmp && counts && offsets && bucketStart &&
+              tasks;
+    if (!ok) {
+        fprintf(stderr, "Memory allocation failed for sample sort\n");
+        goto done;
+    }
+
+    // Evenly spaced splitters from a sorted pseudo-random sample
+    uint64_t state = 0x9E3779B97F4A7C15ULL ^ n;
+    for (size_t i = 0; i < sampleSize; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        sample[i] = data[state % n];
+    }
+    qsort(sample, sampleSize, sizeof(int64_t), compareInt64);
+    for (size_t b = 1; b < threads; b++)
+        splitters[b - 1] = sample[b * SAMPLE_OVERSAMPLING];
+
+    SampleSortShared shared = {data,    tmp,    n,          threads,
+                               splitters, counts, offsets, bucketStart};
+    for (size_t t = 0; t < threads; t++)
+        tasks[t] = (SampleSortTask){&shared, t};
+
+    ok = runPhase(tasks, threads, sampleSortCount);
+
+    // Bucket b collects the slices of threads 0..threads-1 in order
+    size_t sum = 0;
+    for (size_t b = 0; b < threads; b++) {
+        bucketStart[b] = sum;
+        for (size_t t = 0; t < threads; t++) {
+            offsets[t * threads + b] = sum;
+            sum += counts[t * threads + b];
+        }
+    }
+    bucketStart[threads] = sum;
+
+    ok = ok && runPhase(tasks, threads, sampleSortScatter);
+    ok = ok && runPhase(tasks, threads, sampleSortBucket);
+
+done:
+    free(sample);
+    free(splitters);
+    free(tmp);
+    free(counts);
+    free(offsets);
+    free(bucketStart);
+    free(tasks);
+    return ok;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static bool isSortedInt64(const int64_t *data, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        if (data[i - 1] > data[i])
+            return false;
+    }
+    return true;
+}
+
+// qsort, radix sort and sample sort on the same n random int64_t values
+static void benchmark(size_t n, size_t threads) {
+    int64_t *original = malloc(n * sizeof(int64_t));
+    int64_t *work = malloc(n * sizeof(int64_t));
+    if (!original || !work) {
+        free(original);
+        free(work);
+        return;
+    }
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    for (size_t i = 0; i < n; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        original[i] = (int64_t)state;
+    }
+
+    memcpy(work, original, n * sizeof(int64_t));
+    double start = nowSeconds();
+    qsort(work, n, sizeof(int64_t), compareInt64);
+    double quick = nowSeconds() - start;
+
+    memcpy(work, original, n * sizeof(int64_t));
+    start = nowSeconds();
+    int64RadixSort(work, n);
+    double radix = nowSeconds() - start;
+    bool sorted = isSortedInt64(work, n);
+
+    memcpy(work, original, n * sizeof(int64_t));
+    start = nowSeconds();
+    int64ParallelSampleSort(work, n, threads);
+    double sample = nowSeconds() - start;
+    sorted &= isSortedInt64(work, n);
+
+    printf("%5zuM int64: qsort %6.2f s, radix %6.2f s, sample sort "
+           "(%zu threads) %6.2f s%s\n",
+           n / 1000000, quick, radix, threads, sample,
+           sorted ? "" : "  UNSORTED");
+    free(original);
+    free(work);
+}
+
+int main(void) {
+    IntegerDynamicArray vec = {NULL, 0, 0};
+    int values[] = {42, -7, 13, 2147483647, 0, -2147483647 - 1, 13, -50, 7};
+    size_t count = sizeof(values) / sizeof(*values);
+    vec.data = malloc(sizeof(values));
+    if (!vec.data)
+        return EXIT_FAILURE;
+    memcpy(vec.data, values, sizeof(values));
+    vec.size = vec.capacity = count;
+
+    size_t permutation[sizeof(values) / sizeof(*values)];
+    integerSortPermutation(vec.data, vec.size, permutation);
+    printf("Sorting permutation:");
+    for (size_t i = 0; i < count; i++)
+        printf(" %zu", permutation[i]);
+    printf("\n");
+
+    sortIntegerDynamicArray(&vec);
+    printf("Sorted array:");
+    for (size_t i = 0; i < vec.size; i++)
+        printf(" %d", vec.data[i]);
+    printf("\n");
+    free(vec.data);
+
+    // Keys with a payload: the payload follows its key
+    int64_t keys[] = {30, -10, 20, -10, 0};
+    uint64_t payload[] = {'a', 'b', 'c', 'd', 'e'};
+    int64RadixSortWithPayload(keys, payload, 5);
+    printf("Sorted pairs:");
+    for (size_t i = 0; i < 5; i++)
+        printf(" (%ld, %c)", keys[i], (char)payload[i]);
+    printf("\n\n");
+
+    benchmark(1000000, 4);
+    benchmark(10000000, 4);
+    benchmark(100000000, 4);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,333 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Structure to hold the dynamic integer array (as in integerDynamicArray.c)
+typedef struct {
+    int *data;       // Pointer to the array holding the data
+    size_t size;     // Current number of elements in the array
+    size_t capacity; // Current capacity of the array (adjustable)
+} IntegerDynamicArray;
+
+// Read-only search index over a snapshot of an IntegerDynamicArray.
+// The values are stored in Eytzinger order: the sorted sequence laid out as
+// an implicit binary search tree in BFS order (node k has children 2k and
+// 2k+1, 1-based). A lookup touches the same nodes as a binary search, but the
+// top levels share a few hot cache lines and the 16 descendants four levels
+// down sit in one line that can be prefetched while the next three
+// comparisons run. The descent has no data-dependent branches.
+// The index must be rebuilt after the array changes.
+typedef struct {
+    int *keys;           // Eytzinger-ordered values, keys[1..size]
+    uint32_t *ranks;     // ranks[k]: position of keys[k] in sorted order
+    uint32_t *positions; // positions[k]: index of keys[k] in the array
+    size_t size;         // number of indexed values
+} IntegerSortedIndex;
+
+#define CACHE_LINE_SIZE 64
+// Keys per cache line: prefetching node 16k fetches all of k's descendants
+// four levels down
+#define KEYS_PER_LINE (CACHE_LINE_SIZE / sizeof(int))
+
+// Initialize the dynamic integer array with the given initial capacity
+bool initializeIntegerDynamicArray(IntegerDynamicArray *array,
+                                   size_t initialCapacity) {
+    array->data = (int *)calloc(initialCapacity, sizeof(int));
+    if (array->data == NULL) {
+        fprintf(stderr, "Memory allocation failed during initialization\n");
+        return false;
+    }
+    array->size = 0;
+    array->capacity = initialCapacity;
+    return true;
+}
+
+// Free memory allocated for the dynamic integer array
+void freeIntegerDynamicArray(IntegerDynamicArray *array) {
+    free(array->data);
+    array->data = NULL;
+    array->size = 0;
+    array->capacity = 0;
+}
+
+// Sort the values of an array together with their original positions.
+// LSD radix sort over the 4 bytes of the sign-flipped value: it is stable,
+// so equal values keep ascending positions.
+static bool sortWithPositions(const int *data, size_t n, uint32_t **keysOut,
+                              uint32_t **positionsOut) {
+    uint32_t *keys = malloc(n * sizeof(uint32_t));
+    uint32_t *positions = malloc(n * sizeof(uint32_t));
+    uint32_t *keysTmp = malloc(n * sizeof(uint32_t));
+    uint32_t *positionsTmp = malloc(n * sizeof(uint32_t));
+    if (!keys || !positions || !keysTmp || !positionsTmp) {
+        fprintf(stderr, "Memory allocation failed while sorting\n");
+        free(keys);
+        free(positions);
+        free(keysTmp);
+        free(positionsTmp);
+        return false;
+    }
+    for (size_t i = 0; i < n; i++) {
+        keys[i] = (uint32_t)data[i] ^ 0x80000000u;
+        positions[i] = (uint32_t)i;
+    }
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        size_t offsets[256] = {0};
+        for (size_t i = 0; i < n; i++)
+            offsets[(keys[i] >> shift) & 0xFF]++;
+        size_t sum = 0;
+        for (int b = 0; b < 256; b++) {
+            size_t count = offsets[b];
+            offsets[b] = sum;
+            sum += count;
+        }
+        for (size_t i = 0; i < n; i++) {
+            size_t to = offsets[(keys[i] >> shift) & 0xFF]++;
+            keysTmp[to] = keys[i];
+            positionsTmp[to] = positions[i];
+        }
+        uint32_t *t = keys;
+        keys = keysTmp;
+        keysTmp = t;
+        t = positions;
+        positions = positionsTmp;
+        positionsTmp = t;
+    }
+
+    free(keysTmp);
+    free(positionsTmp);
+    *keysOut = keys;
+    *positionsOut = positions;
+    return true;
+}
+
+// Fill the Eytzinger layout by an in-order walk of the implicit tree
+static size_t eytzingerFill(IntegerSortedIndex *index, const uint32_t *sorted,
+                            const uint32_t *sortedPositions, size_t rank,
+                            size_t k) {
+    if (k > index->size)
+        return rank;
+    rank = eytzingerFill(index, sorted, sortedPositions, rank, 2 * k);
+    index->keys[k] = (int)(sorted[rank] ^ 0x80000000u);
+    index->ranks[k] = (uint32_t)rank;
+    index->positions[k] = sortedPositions[rank];
+    rank++;
+    return eytzingerFill(index, sorted, sortedPositions, rank, 2 * k + 1);
+}
+
+// Build a sorted index over the current contents of `array`.
+// Arrays of up to UINT32_MAX elements are supported.
+bool initializeIntegerSortedIndex(IntegerSortedIndex *index,
+                                  const IntegerDynamicArray *array) {
+    size_t n = array->size;
+    if (n > UINT32_MAX) {
+        fprintf(stderr, "Array of %zu elements is too large to index\n", n);
+        return false;
+    }
+
+    // keys[0] is unused so that keys[16k] starts a cache line
+    size_t bytes = (n + 1) * sizeof(int);
+    bytes = (bytes + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+    index->keys = aligned_alloc(CACHE_LINE_SIZE, bytes);
+    index->ranks = malloc((n + 1) * sizeof(uint32_t));
+    index->positions = malloc((n + 1) * sizeof(uint32_t));
+    index->size = n;
+    uint32_t *sorted = NULL, *sortedPositions = NULL;
+    if (!index->keys || !index->ranks || !index->positions ||
+        !sortWithPositions(array->data, n, &sorted, &sortedPositions)) {
+        fprintf(stderr, "Memory allocation failed for sorted index\n");
+        free(index->keys);
+        free(index->ranks);
+        free(index->positions);
+        index->keys = NULL;
+        index->ranks = index->positions = NULL;
+        index->size = 0;
+        return false;
+    }
+
+    eytzingerFill(index, sorted, sortedPositions, 0, 1);
+    free(sorted);
+    free(sortedPositions);
+    return true;
+}
+
+// Free memory allocated for the sorted index
+void freeIntegerSortedIndex(IntegerSortedIndex *index) {
+    free(index->keys);
+    free(index->ranks);
+    free(index->positions);
+    index->keys = NULL;
+    index->ranks = index->positions = NULL;
+    index->size = 0;
+}
+
+// Descend the tree, going right past every key < value (<= value for an
+// upper bound). The path taken is recorded in the bits of k; stripping the
+// trailing right turns and the final left turn leaves the last node where we
+// went left, which is the answer, or 0 if we never went left.
+static inline size_t eytzingerSearch(const IntegerSortedIndex *index,
+                                     int value, bool upper) {
+    size_t k = 1;
+    while (k <= index->size) {
+        __builtin_prefetch(index->keys + KEYS_PER_LINE * k);
+        int key = index->keys[k];
+        k = 2 * k + (upper ? key <= value : key < value);
+    }
+    return k >> __builtin_ffsll((long long)~k);
+}
+
+// Return the sorted rank of the first value >= `value` (size if none)
+size_t lowerBoundIntegerSortedIndex(const IntegerSortedIndex *index,
+                                    int value) {
+    size_t k = eytzingerSearch(index, value, false);
+    return k == 0 ? index->size : index->ranks[k];
+}
+
+// Return the sorted rank of the first value > `value` (size if none)
+size_t upperBoundIntegerSortedIndex(const IntegerSortedIndex *index,
+                                    int value) {
+    size_t k = eytzingerSearch(index, value, true);
+    return k == 0 ? index->size : index->ranks[k];
+}
+
+// Set [*first, *last) to the sorted ranks holding `value`; return the count
+size_t equalRangeIntegerSortedIndex(const IntegerSortedIndex *index,
+                                    int value, size_t *first, size_t *last) {
+    *first = lowerBoundIntegerSortedIndex(index, value);
+    *last = upperBoundIntegerSortedIndex(index, value);
+    return *last - *first;
+}
+
+// Find the array index of the first occurrence of `value`, like
+// findIntegerDynamicArray() but in O(log n).
+// Returns true and sets *position if found; returns false otherwise.
+bool findIntegerSortedIndex(const IntegerSortedIndex *index, int value,
+                            size_t *position) {
+    size_t k = eytzingerSearch(index, value, false);
+    if (k == 0 || index->keys[k] != value)
+        return false;
+    *position = index->positions[k];
+    return true;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Plain binary search over a sorted array (the baseline)
+static size_t binarySearchLowerBound(const int *sorted, size_t n, int value) {
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (sorted[mid] < value)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+// Query throughput of the Eytzinger index and of binary search over the
+// sorted array, for n random values and `queries` random lookups
+static void benchmark(size_t n, size_t queries) {
+    IntegerDynamicArray array;
+    if (!initializeIntegerDynamicArray(&array, n))
+        return;
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    for (size_t i = 0; i < n; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        array.data[i] = (int)(uint32_t)state;
+    }
+    array.size = n;
+
+    double start = nowSeconds();
+    IntegerSortedIndex index;
+    if (!initializeIntegerSortedIndex(&index, &array)) {
+        freeIntegerDynamicArray(&array);
+        return;
+    }
+    double built = nowSeconds() - start;
+
+    // The baseline searches the sorted values in plain order
+    int *sorted = malloc(n * sizeof(int));
+    int *probes = malloc(queries * sizeof(int));
+    if (!sorted || !probes) {
+        free(sorted);
+        free(probes);
+        freeIntegerSortedIndex(&index);
+        freeIntegerDynamicArray(&array);
+        return;
+    }
+    for (size_t k = 1; k <= n; k++)
+        sorted[index.ranks[k]] = index.keys[k];
+    for (size_t q = 0; q < queries; q++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        probes[q] = (int)(uint32_t)state;
+    }
+
+    start = nowSeconds();
+    size_t binarySum = 0;
+    for (size_t q = 0; q < queries; q++)
+        binarySum += binarySearchLowerBound(sorted, n, probes[q]);
+    double middle = nowSeconds();
+    size_t eytzingerSum = 0;
+    for (size_t q = 0; q < queries; q++)
+        eytzingerSum += lowerBoundIntegerSortedIndex(&index, probes[q]);
+    double end = nowSeconds();
+
+    printf("%5zuM elements (build %.1f s): binary search %6.2f Mq/s, "
+           "Eytzinger %6.2f Mq/s%s\n",
+           n / 1000000, built, (double)queries / (middle - start) / 1e6,
+           (double)queries / (end - middle) / 1e6,
+           binarySum == eytzingerSum ? "" : "  MISMATCH");
+
+    free(sorted);
+    free(probes);
+    freeIntegerSortedIndex(&index);
+    freeIntegerDynamicArray(&array);
+}
+
+int main(void) {
+    IntegerDynamicArray vec;
+    if (!initializeIntegerDynamicArray(&vec, 16))
+        return EXIT_FAILURE;
+    int values[] = {42, -7, 13, 42, 0, 99, 13, 42, -50, 7, 13, 64};
+    vec.size = sizeof(values) / sizeof(*values);
+    memcpy(vec.data, values, sizeof(values));
+
+    IntegerSortedIndex index;
+    if (!initializeIntegerSortedIndex(&index, &vec)) {
+        freeIntegerDynamicArray(&vec);
+        return EXIT_FAILURE;
+    }
+
+    int queries[] = {13, 42, 8, -100, 100};
+    for (size_t q = 0; q < sizeof(queries) / sizeof(*queries); q++) {
+        size_t first, last, position;
+        size_t count =
+            equalRangeIntegerSortedIndex(&index, queries[q], &first, &last);
+        printf("%4d: ranks [%zu, %zu), %zu occurrence(s)", queries[q], first,
+               last, count);
+        if (findIntegerSortedIndex(&index, queries[q], &position))
+            printf(", first at array index %zu", position);
+        printf("\n");
+    }
+    freeIntegerSortedIndex(&index);
+    freeIntegerDynamicArray(&vec);
+
+    printf("\nlower_bound throughput, 10M random queries:\n");
+    benchmark(1000000, 10000000);
+    benchmark(10000000, 10000000);
+    benchmark(100000000, 10000000);
+    return EXIT_SUCCESS;
+}
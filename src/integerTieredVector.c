@@ -0,0 +1,482 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Structure to hold the dynamic integer array (as in integerDynamicArray.c)
+typedef struct {
+    int *data;       // Pointer to the array holding the data
+    size_t size;     // Current number of elements in the array
+    size_t capacity; // Current capacity of the array (adjustable)
+} IntegerDynamicArray;
+
+// ---------------------------------------------------------------------------
+// Tiered vector
+//
+// The elements live in blocks of B = 2^blockBits slots, each a circular
+// buffer with its own head. Every block but the last is full, so element i
+// is slot (head + i % B) % B of block i / B: two shifts and a mask.
+//
+// Inserting at i shifts the shorter side of block i / B by one slot, which
+// pushes one element out of its end; every later block takes that element
+// at its front and pushes out its own last one, in O(1) thanks to the
+// circular layout. Erasing is the mirror image. Both cost O(B + n / B),
+// and B is kept near sqrt(n): when the block count drifts past 2B or below
+// B / 4, the vector is rebuilt with the block size doubled or halved.
+// ---------------------------------------------------------------------------
+
+#define TIERED_MIN_BLOCK_BITS 6
+
+typedef struct {
+    int **blocks;             // Circular blocks of 2^blockBits elements
+    size_t *heads;            // Slot of the first element of each block
+    size_t blockCount;        // Blocks in use; all but the last are full
+    size_t directoryCapacity; // Entries allocated in blocks and heads
+    unsigned blockBits;
+    size_t size; // Current number of elements
+} IntegerTieredVector;
+
+static inline size_t blockMask(const IntegerTieredVector *tv) {
+    return ((size_t)1 << tv->blockBits) - 1;
+}
+
+static inline int *slot(const IntegerTieredVector *tv, size_t block,
+                        size_t position) {
+    return &tv->blocks[block][(tv->heads[block] + position) & blockMask(tv)];
+}
+
+// Initialize an empty tiered vector
+void initializeIntegerTieredVector(IntegerTieredVector *tv) {
+    memset(tv, 0, sizeof(*tv));
+    tv->blockBits = TIERED_MIN_BLOCK_BITS;
+}
+
+// Free every block of the tiered vector
+void freeIntegerTieredVector(IntegerTieredVector *tv) {
+    for (size_t b = 0; b < tv->blockCount; b++)
+        free(tv->blocks[b]);
+    free(tv->blocks);
+    free(tv->heads);
+    initializeIntegerTieredVector(tv);
+}
+
+// Append an empty block
+static bool addBlock(IntegerTieredVector *tv) {
+    if (tv->blockCount == tv->directoryCapacity) {
+        size_t capacity = tv->directoryCapacity ? 2 * tv->directoryCapacity
+                                                : 16;
+        int **blocks = realloc(tv->blocks, capacity * sizeof(int *));
+        if (blocks)
+            tv->blocks = blocks;
+        size_t *heads = realloc(tv->heads, capacity * sizeof(size_t));
+        if (heads)
+            tv->heads = heads;
+        if (!blocks || !heads) {
+            fprintf(stderr, "Memory allocation failed for the directory\n");
+            return false;
+        }
+        tv->directoryCapacity = capacity;
+    }
+    int *block = malloc(sizeof(int) << tv->blockBits);
+    if (!block) {
+        fprintf(stderr, "Memory allocation failed for a block\n");
+        return false;
+    }
+    tv->blocks[tv->blockCount] = block;
+    tv->heads[tv->blockCount] = 0;
+    tv->blockCount++;
+    return true;
+}
+
+// Move logical slots [from, to) of a circular block one slot left
+// (delta = -1) or right (delta = +1); one memmove unless the span wraps
+static void moveSlots(int *block, size_t head, size_t mask, size_t from,
+                      size_t to, int delta) {
+    if (from >= to)
+        return;
+    // Physical positions, offset by one lap so that from - 1 cannot wrap
+    size_t first = head + mask + 1 + from;
+    size_t lastTouched = head + mask + to + (delta > 0);
+    size_t firstTouched = first - (delta < 0);
+    if ((firstTouched & ~mask) == (lastTouched & ~mask)) {
+        memmove(block + ((first + delta) & mask), block + (first & mask),
+                (to - from) * sizeof(int));
+    } else if (delta < 0) {
+        for (size_t j = from; j < to; j++)
+            block[(head + j - 1) & mask] = block[(head + j) & mask];
+    } else {
+        for (size_t j = to; j-- > from;)
+            block[(head + j + 1) & mask] = block[(head + j) & mask];
+    }
+}
+
+// Insert into a block holding `count` elements at logical `position`,
+// shifting the shorter side. A full block pushes out and returns its last
+// element.
+static int insertIntoBlock(IntegerTieredVector *tv, size_t b,
+                           size_t position, size_t count, int value) {
+    size_t mask = blockMask(tv);
+    int *block = tv->blocks[b];
+    size_t head = tv->heads[b];
+    int out = block[(head + mask) & mask];
+    if (position < count / 2) {
+        // Open a slot before the front; in a full block that slot held
+        // the last element, saved in `out`
+        head = (head - 1) & mask;
+        tv->heads[b] = head;
+        moveSlots(block, head, mask, 1, position + 1, -1);
+    } else {
+        moveSlots(block, head, mask, position,
+                  count == mask + 1 ? count - 1 : count, +1);
+    }
+    block[(head + position) & mask] = value;
+    return out;
+}
+
+// Remove logical `position` from a block holding `count` elements by
+// shifting the shorter side; the freed slot ends up at the back
+static void removeFromBlock(IntegerTieredVector *tv, size_t b,
+                            size_t position, size_t count) {
+    size_t mask = blockMask(tv);
+    if (position < count / 2) {
+        moveSlots(tv->blocks[b], tv->heads[b], mask, 0, position, +1);
+        tv->heads[b] = (tv->heads[b] + 1) & mask;
+    } else {
+        moveSlots(tv->blocks[b], tv->heads[b], mask, position + 1, count,
+                  -1);
+    }
+}
+
+// Copy the elements into out (tv->size values)
+void flattenIntegerTieredVector(const IntegerTieredVector *tv, int *out) {
+    size_t blockSize = (size_t)1 << tv->blockBits;
+    for (size_t b = 0, copied = 0; b < tv->blockCount; b++) {
+        size_t count = tv->size - copied;
+        count = count < blockSize ? count : blockSize;
+        size_t head = tv->heads[b];
+        size_t firstPart = count < blockSize - head ? count : blockSize - head;
+        memcpy(out + copied, tv->blocks[b] + head, firstPart * sizeof(int));
+        memcpy(out + copied + firstPart, tv->blocks[b],
+               (count - firstPart) * sizeof(int));
+        copied += count;
+    }
+}
+
+// Fill an empty tiered vector with n values
+static bool fillIntegerTieredVector(IntegerTieredVector *tv, const int *data,
+                                    size_t n) {
+    size_t blockSize = (size_t)1 << tv->blockBits;
+    for (size_t copied = 0; copied < n; copied += blockSize) {
+        if (!addBlock(tv))
+            return false;
+        size_t count = n - copied < blockSize ? n - copied : blockSize;
+        memcpy(tv->blocks[tv->blockCount - 1], data + copied,
+               count * sizeof(int));
+    }
+    tv->size = n;
+    return true;
+}
+
+// Smallest block size with at most as many blocks as elements per block
+static unsigned blockBitsFor(size_t n) {
+    unsigned bits = TIERED_MIN_BLOCK_BITS;
+    while (bits < 31 && ((size_t)1 << (2 * bits)) < n)
+        bits++;
+    return bits;
+}
+
+// Build a tiered vector holding a copy of the flat array, in O(n)
+bool initializeIntegerTieredVectorFromArray(IntegerTieredVector *tv,
+                                            const IntegerDynamicArray *array) {
+    initializeIntegerTieredVector(tv);
+    tv->blockBits = blockBitsFor(array->size);
+    if (!fillIntegerTieredVector(tv, array->data, array->size)) {
+        freeIntegerTieredVector(tv);
+        return false;
+    }
+    return true;
+}
+
+// Redistribute the elements into blocks of 2^blockBits; on failure the
+// vector keeps its current layout
+static void rebuildIntegerTieredVector(IntegerTieredVector *tv,
+                                       unsigned blockBits) {
+    int *flat = malloc(tv->size * sizeof(int));
+    if (!flat)
+        return;
+    flattenIntegerTieredVector(tv, flat);
+    IntegerTieredVector rebuilt;
+    initializeIntegerTieredVector(&rebuilt);
+    rebuilt.blockBits = blockBits;
+    if (fillIntegerTieredVector(&rebuilt, flat, tv->size)) {
+        freeIntegerTieredVector(tv);
+        *tv = rebuilt;
+    } else {
+        freeIntegerTieredVector(&rebuilt);
+    }
+    free(flat);
+}
+
+// Store the element at `index` into *value
+bool getIntegerTieredVector(const IntegerTieredVector *tv, size_t index,
+                            int *value) {
+    if (index >= tv->size) {
+        fprintf(stderr, "Index %zu out of range (size %zu)\n", index,
+                tv->size);
+        return false;
+    }
+    *value = *slot(tv, index >> tv->blockBits, index & blockMask(tv));
+    return true;
+}
+
+// Overwrite the element at `index`
+bool setIntegerTieredVector(IntegerTieredVector *tv, size_t index,
+                            int value) {
+    if (index >= tv->size) {
+        fprintf(stderr, "Index %zu out of range (size %zu), cannot set\n",
+                index, tv->size);
+        return false;
+    }
+    *slot(tv, index >> tv->blockBits, index & blockMask(tv)) = value;
+    return true;
+}
+
+// Insert a value before position `index` (index == size appends)
+bool insertIntegerTieredVector(IntegerTieredVector *tv, size_t index,
+                               int value) {
+    if (index > tv->size) {
+        fprintf(stderr, "Index %zu out of range (size %zu), cannot insert\n",
+                index, tv->size);
+        return false;
+    }
+    size_t blockSize = (size_t)1 << tv->blockBits;
+    size_t b = index >> tv->blockBits;
+    if (b == tv->blockCount) {
+        // Appending after a full last block
+        if (!addBlock(tv))
+            return false;
+    }
+    size_t last = tv->blockCount - 1;
+    size_t lastCount = tv->size - (last << tv->blockBits);
+    // A full last block overflows into a new one; add it before anything
+    // moves so a failed allocation leaves the vector unchanged
+    if (lastCount == blockSize && !addBlock(tv))
+        return false;
+    size_t position = index & blockMask(tv);
+    int carry = insertIntoBlock(tv, b, position,
+                                b == last ? lastCount : blockSize, value);
+    // Every full block passes its last element on to the next block
+    for (size_t c = b + 1; c <= last; c++)
+        carry = insertIntoBlock(tv, c, 0, c == last ? lastCount : blockSize,
+                                carry);
+    if (lastCount == blockSize)
+        tv->blocks[tv->blockCount - 1][0] = carry;
+    tv->size++;
+
+    if (tv->blockCount > 2 * blockSize)
+        rebuildIntegerTieredVector(tv, tv->blockBits + 1);
+    return true;
+}
+
+// Remove the element at `index`, storing it into *value if value is not
+// NULL
+bool eraseIntegerTieredVector(IntegerTieredVector *tv, size_t index,
+                              int *value) {
+    if (index >= tv->size) {
+        fprintf(stderr, "Index %zu out of range (size %zu), cannot erase\n",
+                index, tv->size);
+        return false;
+    }
+    size_t blockSize = (size_t)1 << tv->blockBits;
+    size_t b = index >> tv->blockBits;
+    size_t position = index & blockMask(tv);
+    size_t last = tv->blockCount - 1;
+    size_t lastCount = tv->size - (last << tv->blockBits);
+    if (value)
+        *value = *slot(tv, b, position);
+
+    removeFromBlock(tv, b, position, b == last ? lastCount : blockSize);
+    // Every later block hands its first element back to the previous
+    // block, whose free slot is at the back
+    for (size_t c = b + 1; c <= last; c++) {
+        *slot(tv, c - 1, blockSize - 1) = *slot(tv, c, 0);
+        tv->heads[c] = (tv->heads[c] + 1) & blockMask(tv);
+    }
+    if (lastCount == 1) {
+        free(tv->blocks[last]);
+        tv->blockCount--;
+    }
+    tv->size--;
+
+    if (tv->blockBits > TIERED_MIN_BLOCK_BITS &&
+        tv->blockCount < blockSize / 4)
+        rebuildIntegerTieredVector(tv, tv->blockBits - 1);
+    return true;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static inline uint64_t xorshift64(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// Flat-array insert and erase: memmove of the tail, as
+// eraseIntegerDynamicArray does
+static void flatInsert(IntegerDynamicArray *vec, size_t index, int value) {
+    memmove(vec->data + index + 1, vec->data + index,
+            (vec->size - index) * sizeof(int));
+    vec->data[index] = value;
+    vec->size++;
+}
+
+static int flatErase(IntegerDynamicArray *vec, size_t index) {
+    int value = vec->data[index];
+    memmove(vec->data + index, vec->data + index + 1,
+            (vec->size - index - 1) * sizeof(int));
+    vec->size--;
+    return value;
+}
+
+// Run `ops` random operations (insert, erase or read at a random index, one
+// third each) on a tiered vector and, if `mirror` is not NULL, the same
+// operations on a flat array. Return the checksum of values read.
+static uint64_t mixedOps(IntegerTieredVector *tv, IntegerDynamicArray *mirror,
+                         size_t ops, uint64_t seed, bool *agree) {
+    uint64_t state = seed, checksum = 0;
+    for (size_t i = 0; i < ops; i++) {
+        uint64_t r = xorshift64(&state);
+        size_t n = tv ? tv->size : mirror->size;
+        int tvValue = 0, flatValue = 0;
+        switch (r % 3) {
+        case 0: {
+            size_t index = (size_t)(r >> 8) % (n + 1);
+            if (tv)
+                insertIntegerTieredVector(tv, index, (int)i);
+            if (mirror)
+                flatInsert(mirror, index, (int)i);
+            continue;
+        }
+        case 1: {
+            size_t index = (size_t)(r >> 8) % n;
+            if (tv)
+                eraseIntegerTieredVector(tv, index, &tvValue);
+            if (mirror)
+                flatValue = flatErase(mirror, index);
+            break;
+        }
+        default: {
+            size_t index = (size_t)(r >> 8) % n;
+            if (tv)
+                getIntegerTieredVector(tv, index, &tvValue);
+            if (mirror)
+                flatValue = mirror->data[index];
+            break;
+        }
+        }
+        if (tv && mirror && tvValue != flatValue)
+            *agree = false;
+        checksum += (uint64_t)(tv ? tvValue : flatValue);
+    }
+    return checksum;
+}
+
+// Random inserts, erases and reads on n elements: tiered vector against
+// the flat array
+static void benchmark(size_t n, size_t tieredOps, size_t flatOps) {
+    IntegerDynamicArray vec = {malloc((n + flatOps) * sizeof(int)), n,
+                               n + flatOps};
+    if (!vec.data)
+        return;
+    for (size_t i = 0; i < n; i++)
+        vec.data[i] = (int)i;
+
+    IntegerTieredVector tv;
+    double start = nowSeconds();
+    if (!initializeIntegerTieredVectorFromArray(&tv, &vec)) {
+        free(vec.data);
+        return;
+    }
+    double build = nowSeconds() - start;
+
+    start = nowSeconds();
+    mixedOps(&tv, NULL, tieredOps, 42, NULL);
+    double tiered = nowSeconds() - start;
+    start = nowSeconds();
+    mixedOps(NULL, &vec, flatOps, 42, NULL);
+    double flat = nowSeconds() - start;
+    printf("%5zuM elements (blocks of %zu): build %.1f ms, tiered "
+           "%.2f us/op, flat %.2f us/op\n",
+           n / 1000000, (size_t)1 << tv.blockBits, build * 1e3,
+           tiered / (double)tieredOps * 1e6, flat / (double)flatOps * 1e6);
+    freeIntegerTieredVector(&tv);
+    free(vec.data);
+}
+
+int main(void) {
+    IntegerTieredVector tv;
+    initializeIntegerTieredVector(&tv);
+    for (int i = 0; i < 10; i++)
+        insertIntegerTieredVector(&tv, tv.size, i * 10);
+    insertIntegerTieredVector(&tv, 0, -1);
+    insertIntegerTieredVector(&tv, 5, 999);
+    eraseIntegerTieredVector(&tv, 2, NULL);
+    printf("Tiered vector:");
+    for (size_t i = 0; i < tv.size; i++) {
+        int value;
+        getIntegerTieredVector(&tv, i, &value);
+        printf(" %d", value);
+    }
+    printf("\n");
+    freeIntegerTieredVector(&tv);
+
+    // The same random operations on both structures, growing and shrinking
+    // through several block sizes
+    size_t n = 1000, growth = 300000, ops = 400000;
+    IntegerDynamicArray vec = {malloc((n + growth + ops) * sizeof(int)), n,
+                               n + growth + ops};
+    if (!vec.data)
+        return EXIT_FAILURE;
+    for (size_t i = 0; i < n; i++)
+        vec.data[i] = (int)(i * 7);
+    initializeIntegerTieredVectorFromArray(&tv, &vec);
+    uint64_t state = 99;
+    for (size_t i = 0; i < growth; i++) {
+        size_t index = (size_t)xorshift64(&state) % (vec.size + 1);
+        insertIntegerTieredVector(&tv, index, -(int)i);
+        flatInsert(&vec, index, -(int)i);
+    }
+    unsigned largestBits = tv.blockBits;
+    bool agree = true;
+    mixedOps(&tv, &vec, ops, 7, &agree);
+    while (vec.size > 10) {
+        size_t index = (size_t)xorshift64(&state) % vec.size;
+        int value;
+        eraseIntegerTieredVector(&tv, index, &value);
+        agree &= value == flatErase(&vec, index);
+    }
+    int flat[10];
+    agree &= tv.size == vec.size;
+    if (agree) {
+        flattenIntegerTieredVector(&tv, flat);
+        agree = memcmp(flat, vec.data, vec.size * sizeof(int)) == 0;
+    }
+    printf("Grew to %zu elements, %zu mixed operations, shrank to %zu "
+           "(blocks of %zu to %zu) against the flat array: %s\n\n",
+           n + growth, ops, vec.size, (size_t)1 << tv.blockBits,
+           (size_t)1 << largestBits, agree ? "identical" : "MISMATCH");
+    free(vec.data);
+    freeIntegerTieredVector(&tv);
+
+    benchmark(1000000, 1000000, 20000);
+    benchmark(10000000, 1000000, 2000);
+    return EXIT_SUCCESS;
+}